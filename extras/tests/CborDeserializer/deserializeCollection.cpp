@@ -0,0 +1,143 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+static void check(const std::string& input, const char* expectedJson) {
+  DynamicJsonDocument doc(4096);
+
+  DeserializationError error = deserializeCbor(doc, input);
+
+  CAPTURE(input);
+  REQUIRE(error == DeserializationError::Ok);
+  REQUIRE(doc.as<std::string>() == expectedJson);
+}
+
+TEST_CASE("deserialize CBOR array") {
+  SECTION("definite length") {
+    check("\x80", "[]");
+    check("\x83\x01\x02\x03", "[1,2,3]");
+    check("\x83\x01\x82\x02\x03\x82\x04\x05", "[1,[2,3],[4,5]]");
+    check("\x98\x02\x01\x02", "[1,2]");
+  }
+
+  SECTION("indefinite length") {
+    check("\x9F\xFF", "[]");
+    check("\x9F\x01\x82\x02\x03\x9F\x04\x05\xFF\xFF", "[1,[2,3],[4,5]]");
+    check("\x83\x01\x9F\x02\x03\xFF\x82\x04\x05", "[1,[2,3],[4,5]]");
+  }
+
+  SECTION("size() of an indefinite array") {
+    DynamicJsonDocument doc(4096);
+    deserializeCbor(doc, "\x9F\x01\x02\x03\xFF");
+    REQUIRE(doc.size() == 3);
+  }
+}
+
+TEST_CASE("deserialize CBOR map") {
+  SECTION("definite length") {
+    check("\xA0", "{}");
+    check("\xA2\x61" "a\x01\x61" "b\x82\x02\x03", "{\"a\":1,\"b\":[2,3]}");
+  }
+
+  SECTION("indefinite length") {
+    check("\xBF\xFF", "{}");
+    check("\xBF\x63" "Fun\xF5\x63" "Amt\x21\xFF", "{\"Fun\":true,\"Amt\":-2}");
+  }
+
+  SECTION("indefinite key") {
+    check("\xA1\x7F\x62" "ke\x61" "y\xFF\x01", "{\"key\":1}");
+  }
+
+  SECTION("mutable input") {
+    DynamicJsonDocument doc(4096);
+    char input[] = "\xA2\x61" "a\x7F\x61" "b\x61" "c\xFF\x7F\x61" "d\xFF\x01";
+    DeserializationError error = deserializeCbor(doc, input, sizeof(input) - 1);
+    REQUIRE(error == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":\"bc\",\"d\":1}");
+  }
+}
+
+TEST_CASE("deserializeCbor() round trip") {
+  DynamicJsonDocument doc(4096);
+  deserializeJson(doc,
+                  "{\"name\":\"sensor\",\"values\":[1,-2,1.5,0.1,100000],"
+                  "\"ok\":true,\"next\":null}");
+
+  std::string cbor;
+  serializeCbor(doc, cbor);
+
+  DynamicJsonDocument doc2(4096);
+  DeserializationError error = deserializeCbor(doc2, cbor);
+
+  REQUIRE(error == DeserializationError::Ok);
+  REQUIRE(doc2 == doc);
+}
+
+TEST_CASE("deserializeCbor() with a filter") {
+  DynamicJsonDocument doc(4096);
+  StaticJsonDocument<200> filter;
+  filter["b"] = true;
+
+  // {"a":[1,{"x":"y"}],"b":2,"c":(_ "x" "y")}
+  DeserializationError error = deserializeCbor(
+      doc,
+      "\xA3\x61"
+      "a\x82\x01\xA1\x61x\x61y\x61"
+      "b\x02\x61"
+      "c\x7F\x61x\x61y\xFF",
+      DeserializationOption::Filter(filter));
+
+  REQUIRE(error == DeserializationError::Ok);
+  REQUIRE(doc.as<std::string>() == "{\"b\":2}");
+}
+
+TEST_CASE("deserializeCbor() with a nesting limit") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("definite") {
+    REQUIRE(deserializeCbor(doc, "\x81\x81\x01",
+                            DeserializationOption::NestingLimit(1)) ==
+            DeserializationError::TooDeep);
+    REQUIRE(deserializeCbor(doc, "\x81\x81\x01",
+                            DeserializationOption::NestingLimit(2)) ==
+            DeserializationError::Ok);
+  }
+
+  SECTION("indefinite") {
+    REQUIRE(deserializeCbor(doc, "\xBF\x61" "a\x9F\xFF\xFF",
+                            DeserializationOption::NestingLimit(1)) ==
+            DeserializationError::TooDeep);
+  }
+}
+
+TEST_CASE("deserializeCbor(DeserializationOption::ZeroCopy)") {
+  DynamicJsonDocument doc(4096);
+
+  // {"a":"hello","b":(_ "wor" "ld")}
+  const char input[] = "\xA2\x61" "a\x65hello\x61" "b\x7F\x63wor\x62ld\xFF";
+
+  DeserializationError err = deserializeCbor(
+      doc, input, sizeof(input) - 1, DeserializationOption::ZeroCopy());
+
+  REQUIRE(err == DeserializationError::Ok);
+  REQUIRE(doc["a"].as<JsonString>().c_str() == input + 4);
+  REQUIRE(doc["a"] == "hello");
+  REQUIRE(doc["b"] == "world");  // chunks are copied
+  REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(2) + 2 * 2 + 6);
+}
+
+TEST_CASE("deserializeCbor(..., KeyDictionary)") {
+  static const char* const keys[] = {"a", "b"};
+  DynamicJsonDocument doc(4096);
+
+  DeserializationError err =
+      deserializeCbor(doc, "\xA2\x61" "a\x01\x61" "c\x02", KeyDictionary(keys));
+
+  REQUIRE(err == DeserializationError::Ok);
+  REQUIRE(doc.as<JsonObject>().begin()->key().c_str() == keys[0]);
+  REQUIRE(doc["c"] == 2);
+  REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(2) + JSON_STRING_SIZE(1));
+}
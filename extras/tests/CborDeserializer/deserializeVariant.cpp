@@ -0,0 +1,147 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+template <typename T, typename U>
+static void check(const std::string& input, U expected) {
+  DynamicJsonDocument doc(4096);
+
+  DeserializationError error = deserializeCbor(doc, input);
+
+  CAPTURE(input);
+  REQUIRE(error == DeserializationError::Ok);
+  REQUIRE(doc.is<T>());
+  REQUIRE(doc.as<T>() == expected);
+}
+
+static void checkIsNull(const std::string& input) {
+  DynamicJsonDocument doc(4096);
+
+  DeserializationError error = deserializeCbor(doc, input);
+
+  REQUIRE(error == DeserializationError::Ok);
+  REQUIRE(doc.as<JsonVariant>().isNull());
+}
+
+// The examples come from Appendix A of RFC 8949
+TEST_CASE("deserialize CBOR value") {
+  SECTION("simple values") {
+    check<bool>("\xF4", false);
+    check<bool>("\xF5", true);
+    checkIsNull("\xF6");
+    checkIsNull("\xF7");  // undefined
+    checkIsNull("\xF0");  // simple(16)
+    checkIsNull("\xF8\xFF");
+  }
+
+  SECTION("unsigned integer") {
+    check<int>(std::string("\x00", 1), 0);
+    check<int>("\x17", 23);
+    check<int>("\x18\x18", 24);
+    check<int>("\x18\x64", 100);
+    check<int>("\x19\x03\xE8", 1000);
+    check<uint32_t>(std::string("\x1A\x00\x0F\x42\x40", 5), 1000000U);
+    check<uint32_t>("\x1A\xFF\xFF\xFF\xFF", 4294967295U);
+#if ARDUINOJSON_USE_LONG_LONG
+    check<uint64_t>(std::string("\x1B\x00\x00\x00\xE8\xD4\xA5\x10\x00", 9),
+                    1000000000000U);
+    check<uint64_t>("\x1B\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF",
+                    18446744073709551615U);
+#else
+    checkIsNull("\x1B\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF");  // not supported
+#endif
+  }
+
+  SECTION("negative integer") {
+    check<int>("\x20", -1);
+    check<int>("\x29", -10);
+    check<int>("\x38\x63", -100);
+    check<int>("\x39\x03\xE7", -1000);
+    check<int32_t>("\x3A\x7F\xFF\xFF\xFF", -2147483647 - 1);
+#if ARDUINOJSON_USE_LONG_LONG
+    check<int64_t>("\x3B\x7F\xFF\xFF\xFF\xFF\xFF\xFF\xFF",
+                   -9223372036854775807 - 1);
+    // below the range of int64_t
+    check<double>("\x3B\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF",
+                  -18446744073709551616.0);
+#endif
+  }
+
+  SECTION("half float") {
+    check<float>(std::string("\xF9\x00\x00", 3), 0.0f);
+    check<float>(std::string("\xF9\x3C\x00", 3), 1.0f);
+    check<float>(std::string("\xF9\x3E\x00", 3), 1.5f);
+    check<float>("\xF9\x7B\xFF", 65504.0f);
+    check<float>(std::string("\xF9\x00\x01", 3), 5.960464477539063e-8f);
+    check<float>(std::string("\xF9\x04\x00", 3), 0.00006103515625f);
+    check<float>(std::string("\xF9\xC4\x00", 3), -4.0f);
+
+    DynamicJsonDocument doc(4096);
+    deserializeCbor(doc, std::string("\xF9\x7C\x00", 3));
+    REQUIRE(doc.as<float>() > 3.4e38f);  // infinity
+    deserializeCbor(doc, std::string("\xF9\x7E\x00", 3));
+    REQUIRE(doc.as<float>() != doc.as<float>());  // NaN
+  }
+
+  SECTION("single float") {
+    check<float>(std::string("\xFA\x47\xC3\x50\x00", 5), 100000.0f);
+    check<float>("\xFA\x7F\x7F\xFF\xFF", 3.4028234663852886e+38f);
+  }
+
+  SECTION("double float") {
+    check<double>("\xFB\x3F\xF1\x99\x99\x99\x99\x99\x9A", 1.1);
+    check<double>("\xFB\xC0\x10\x66\x66\x66\x66\x66\x66", -4.1);
+  }
+
+  SECTION("text string") {
+    check<std::string>("\x60", std::string());
+    check<std::string>("\x64IETF", "IETF");
+    check<std::string>("\x62\xC3\xBC", "\xC3\xBC");
+    check<std::string>("\x78\x05hello", "hello");
+    check<std::string>(std::string("\x79\x00\x05hello", 8), "hello");
+  }
+
+  SECTION("indefinite text string") {
+    check<std::string>("\x7F\x65strea\x64ming\xFF", "streaming");
+    check<std::string>("\x7F\xFF", std::string());
+    check<std::string>("\x7F\x60\x78\x01" "a\xFF", "a");
+  }
+
+  SECTION("byte string") {
+    check<JsonBinary>("\x44\x01\x02\x03\x04",
+                      JsonBinary("\x01\x02\x03\x04", 4));
+  }
+
+  SECTION("indefinite byte string") {
+    check<JsonBinary>("\x5F\x42\x01\x02\x43\x03\x04\x05\xFF",
+                      JsonBinary("\x01\x02\x03\x04\x05", 5));
+  }
+
+  SECTION("tags") {
+    SECTION("ignored") {
+      check<std::string>("\xC0\x74" "2013-03-21T20:04:00Z",
+                         "2013-03-21T20:04:00Z");
+      check<int>("\xC1\x1A\x51\x4B\x67\xB0", 1363896240);
+      check<int>("\xDB\x01\x02\x03\x04\x05\x06\x07\x08\x01", 1);
+      check<std::string>("\xD8\x80\x61x", "x");
+    }
+
+    SECTION("below 128 on a byte string: ext") {
+      check<JsonBinary>("\xC1\x42\x01\x02", JsonBinary(1, "\x01\x02", 2));
+      check<JsonBinary>("\xD8\x7F\x41\x01", JsonBinary(127, "\x01", 1));
+      check<JsonBinary>("\xC1\x5F\x41\x01\x41\x02\xFF",
+                        JsonBinary(1, "\x01\x02", 2));
+    }
+
+    SECTION("nested: innermost wins") {
+      check<JsonBinary>("\xD8\x80\xC2\x41\x01", JsonBinary(2, "\x01", 1));
+    }
+
+    SECTION("128 or above on a byte string") {
+      check<JsonBinary>("\xD8\x80\x41\x01", JsonBinary("\x01", 1));
+    }
+  }
+}
@@ -0,0 +1,84 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+static void checkError(const std::string& input,
+                       DeserializationError expected) {
+  DynamicJsonDocument doc(4096);
+  CAPTURE(input);
+  REQUIRE(deserializeCbor(doc, input) == expected);
+}
+
+static void checkAllPrefixesAreIncomplete(const std::string& input) {
+  for (size_t i = 1; i < input.size(); i++) {
+    checkError(input.substr(0, i), DeserializationError::IncompleteInput);
+  }
+  checkError(input, DeserializationError::Ok);
+}
+
+TEST_CASE("deserializeCbor() errors") {
+  SECTION("empty input") {
+    checkError("", DeserializationError::EmptyInput);
+  }
+
+  SECTION("incomplete input") {
+    checkAllPrefixesAreIncomplete("\x1B\x01\x02\x03\x04\x05\x06\x07\x08");
+    checkAllPrefixesAreIncomplete("\x3A\x01\x02\x03\x04");
+    checkAllPrefixesAreIncomplete("\xFB\x3F\xF1\x99\x99\x99\x99\x99\x9A");
+    checkAllPrefixesAreIncomplete("\x64IETF");
+    checkAllPrefixesAreIncomplete("\x7F\x62" "ab\x61" "c\xFF");
+    checkAllPrefixesAreIncomplete("\x9F\x01\x82\x02\x03\xFF");
+    checkAllPrefixesAreIncomplete("\xBF\x61" "a\x01\xFF");
+    checkAllPrefixesAreIncomplete("\xC1\x42\x01\x02");
+  }
+
+  SECTION("reserved additional information") {
+    checkError("\x1C", DeserializationError::InvalidInput);
+    checkError("\x5E", DeserializationError::InvalidInput);
+    checkError("\xFC", DeserializationError::InvalidInput);
+  }
+
+  SECTION("simple value below 32 in the two-byte form") {
+    checkError(std::string("\xF8\x00", 2), DeserializationError::InvalidInput);
+    checkError("\xF8\x14", DeserializationError::InvalidInput);
+    checkError("\xF8\x1F", DeserializationError::InvalidInput);
+    checkError("\xF8\x20", DeserializationError::Ok);
+    checkError("\xF8", DeserializationError::IncompleteInput);
+  }
+
+  SECTION("unexpected break") {
+    checkError("\xFF", DeserializationError::InvalidInput);
+    checkError("\x82\x01\xFF", DeserializationError::InvalidInput);
+  }
+
+  SECTION("indefinite integer") {
+    checkError("\x1F", DeserializationError::InvalidInput);
+  }
+
+  SECTION("invalid chunk") {
+    checkError("\x7F\x41x\xFF", DeserializationError::InvalidInput);
+    checkError("\x7F\x7F\xFF\xFF", DeserializationError::InvalidInput);
+  }
+
+  SECTION("key isn't a text string") {
+    checkError("\xA1\x01\x02", DeserializationError::InvalidInput);
+  }
+
+  SECTION("no memory") {
+    StaticJsonDocument<JSON_ARRAY_SIZE(2)> doc;
+    REQUIRE(deserializeCbor(doc, "\x83\x01\x02\x03") ==
+            DeserializationError::NoMemory);
+    REQUIRE(deserializeCbor(doc, "\x9F\x01\x02\x03\xFF") ==
+            DeserializationError::NoMemory);
+    REQUIRE(deserializeCbor(doc, "\x9F\x01\x02\xFF") ==
+            DeserializationError::Ok);
+  }
+
+  SECTION("length above 32 bits") {
+    checkError(std::string("\x5B\x00\x00\x00\x01\x00\x00\x00\x00", 9),
+               DeserializationError::NoMemory);
+  }
+}
@@ -0,0 +1,75 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+static void check(JsonVariantConst source, const std::string& expected) {
+  std::string actual;
+  size_t len = serializeCbor(source, actual);
+  REQUIRE(len == expected.size());
+  REQUIRE(actual == expected);
+  REQUIRE(measureCbor(source) == expected.size());
+}
+
+TEST_CASE("serialize CBOR array") {
+  DynamicJsonDocument doc(4096);
+  JsonArray array = doc.to<JsonArray>();
+
+  SECTION("empty") {
+    check(array, "\x80");
+  }
+
+  SECTION("three elements") {
+    array.add(1);
+    array.add(2);
+    array.add(3);
+    check(array, "\x83\x01\x02\x03");
+  }
+
+  SECTION("25 elements") {
+    std::string expected = "\x98\x19";
+    for (int i = 1; i <= 25; i++) {
+      array.add(i);
+      expected += char(i < 24 ? i : 0x18);
+      if (i >= 24)
+        expected += char(i);
+    }
+    check(array, expected);
+  }
+
+  SECTION("nested") {
+    array.add(1);
+    JsonArray nested = array.createNestedArray();
+    nested.add(2);
+    nested.add(3);
+    check(array, "\x82\x01\x82\x02\x03");
+  }
+}
+
+TEST_CASE("serialize CBOR map") {
+  DynamicJsonDocument doc(4096);
+  JsonObject object = doc.to<JsonObject>();
+
+  SECTION("empty") {
+    check(object, "\xA0");
+  }
+
+  SECTION("nested array") {
+    object["a"] = 1;
+    object["b"][0] = 2;
+    object["b"][1] = 3;
+    check(object, "\xA2\x61"
+                  "a\x01\x61"
+                  "b\x82\x02\x03");
+  }
+
+  SECTION("fixed size buffer") {
+    object["a"] = "A";
+    char buffer[8];
+    size_t n = serializeCbor(object, buffer, sizeof(buffer));
+    REQUIRE(n == 5);
+    REQUIRE(std::string(buffer, n) == "\xA1\x61\x61\x61\x41");
+  }
+}
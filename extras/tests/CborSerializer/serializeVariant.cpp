@@ -0,0 +1,124 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <limits>
+
+template <typename T>
+static void checkVariant(T value, const char* expected_data,
+                         size_t expected_len) {
+  DynamicJsonDocument doc(4096);
+  JsonVariant variant = doc.to<JsonVariant>();
+  variant.set(value);
+  std::string expected(expected_data, expected_data + expected_len);
+  std::string actual;
+  size_t len = serializeCbor(variant, actual);
+  CAPTURE(variant);
+  REQUIRE(len == expected_len);
+  REQUIRE(actual == expected);
+  REQUIRE(measureCbor(variant) == expected_len);
+}
+
+template <typename T, size_t N>
+static void checkVariant(T value, const char (&expected_data)[N]) {
+  const size_t expected_len = N - 1;
+  checkVariant(value, expected_data, expected_len);
+}
+
+// The examples come from Appendix A of RFC 8949
+TEST_CASE("serialize CBOR value") {
+  SECTION("unbound") {
+    checkVariant(JsonVariant(), "\xF6");
+  }
+
+  SECTION("null") {
+    const char* nil = 0;
+    checkVariant(nil, "\xF6");
+  }
+
+  SECTION("bool") {
+    checkVariant(false, "\xF4");
+    checkVariant(true, "\xF5");
+  }
+
+  SECTION("unsigned integer") {
+    checkVariant(0, "\x00");
+    checkVariant(23, "\x17");
+    checkVariant(24, "\x18\x18");
+    checkVariant(100U, "\x18\x64");
+    checkVariant(1000, "\x19\x03\xE8");
+    checkVariant(1000000, "\x1A\x00\x0F\x42\x40");
+#if ARDUINOJSON_USE_LONG_LONG
+    checkVariant(1000000000000, "\x1B\x00\x00\x00\xE8\xD4\xA5\x10\x00");
+    checkVariant(18446744073709551615U, "\x1B\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF");
+#endif
+  }
+
+  SECTION("negative integer") {
+    checkVariant(-1, "\x20");
+    checkVariant(-10, "\x29");
+    checkVariant(-100, "\x38\x63");
+    checkVariant(-1000, "\x39\x03\xE7");
+    checkVariant(-2147483647 - 1, "\x3A\x7F\xFF\xFF\xFF");
+#if ARDUINOJSON_USE_LONG_LONG
+    checkVariant(-9223372036854775807 - 1,
+                 "\x3B\x7F\xFF\xFF\xFF\xFF\xFF\xFF\xFF");
+#endif
+  }
+
+  SECTION("integral float") {
+    checkVariant(100000.0, "\x1A\x00\x01\x86\xA0");
+    checkVariant(-4.0, "\x23");
+  }
+
+  SECTION("half float") {
+    checkVariant(1.5, "\xF9\x3E\x00");
+    checkVariant(-0.5f, "\xF9\xB8\x00");
+    checkVariant(0.00006103515625, "\xF9\x04\x00");     // smallest normal
+    checkVariant(5.960464477539063e-8, "\xF9\x00\x01");  // subnormal
+    checkVariant(std::numeric_limits<double>::infinity(), "\xF9\x7C\x00");
+    checkVariant(-std::numeric_limits<double>::infinity(), "\xF9\xFC\x00");
+    checkVariant(std::numeric_limits<double>::quiet_NaN(), "\xF9\x7E\x00");
+  }
+
+  SECTION("single float") {
+    checkVariant(3.4028234663852886e+38, "\xFA\x7F\x7F\xFF\xFF");
+    checkVariant(0.1f, "\xFA\x3D\xCC\xCC\xCD");
+  }
+
+#if ARDUINOJSON_USE_DOUBLE
+  SECTION("double float") {
+    checkVariant(1.1, "\xFB\x3F\xF1\x99\x99\x99\x99\x99\x9A");
+    checkVariant(-4.1, "\xFB\xC0\x10\x66\x66\x66\x66\x66\x66");
+  }
+#endif
+
+  SECTION("text string") {
+    checkVariant("", "\x60");
+    checkVariant("IETF", "\x64IETF");
+    checkVariant("\xC3\xBC", "\x62\xC3\xBC");
+    checkVariant(std::string(24, 'x'), "\x78\x18xxxxxxxxxxxxxxxxxxxxxxxx");
+  }
+
+  SECTION("byte string") {
+    checkVariant(JsonBinary("\x01\x02\x03\x04", 4), "\x44\x01\x02\x03\x04");
+  }
+
+  SECTION("ext") {
+    SECTION("positive type becomes a tag") {
+      checkVariant(JsonBinary(1, "\x01\x02", 2), "\xC1\x42\x01\x02");
+      checkVariant(JsonBinary(100, "\x01", 1), "\xD8\x64\x41\x01");
+    }
+
+    SECTION("negative type is dropped") {
+      checkVariant(JsonBinary(-1, "\x01", 1), "\x41\x01");
+    }
+  }
+
+  SECTION("serialized(const char*)") {
+    checkVariant(serialized("\xF5"), "\xF5");
+  }
+}
@@ -86,4 +86,20 @@ TEST_CASE("JsonArray::remove()") {
     JsonArray unboundArray;
     unboundArray.remove(unboundArray.begin());
   }
+
+  SECTION("Reuses the memory of the removed elements") {
+    StaticJsonDocument<JSON_ARRAY_SIZE(2)> doc2;
+    JsonArray array2 = doc2.to<JsonArray>();
+    array2.add(1);
+    array2.add(2);
+
+    for (int i = 0; i < 10; i++) {
+      array2.remove(0);
+      REQUIRE(array2.add(i) == true);
+    }
+
+    REQUIRE(array2.size() == 2);
+    REQUIRE(array2[0] == 8);
+    REQUIRE(array2[1] == 9);
+  }
 }
@@ -28,4 +28,49 @@ TEST_CASE("JsonArray::size()") {
     array[0] = "hello";
     REQUIRE(1U == array.size());
   }
+
+  SECTION("decreases after remove()") {
+    array.add(1);
+    array.add(2);
+    array.add(3);
+
+    array.remove(2);
+    REQUIRE(2U == array.size());
+
+    array.remove(0);
+    REQUIRE(1U == array.size());
+
+    array.add(4);
+    REQUIRE(2U == array.size());
+    REQUIRE(array[1] == 4);
+  }
+
+  SECTION("increases when setting an element after the end") {
+    array.add(1);
+
+    array[3] = 4;
+    REQUIRE(4U == array.size());
+    REQUIRE(array[2].isNull());
+    REQUIRE(array[3] == 4);
+    REQUIRE(array[4].isNull());
+    REQUIRE(4U == array.size());
+  }
+
+  SECTION("is preserved by shrinkToFit()") {
+    array.add(1);
+    array.add(2);
+    doc.shrinkToFit();
+
+    array = doc.as<JsonArray>();
+    REQUIRE(2U == array.size());
+    REQUIRE(array[1] == 2);
+  }
+
+  SECTION("is preserved by a copy") {
+    array.add(1);
+    array.add(2);
+
+    DynamicJsonDocument doc2 = doc;
+    REQUIRE(2U == doc2.size());
+  }
 }
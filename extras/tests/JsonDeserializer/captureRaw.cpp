@@ -0,0 +1,105 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+TEST_CASE("deserializeJson(DeserializationOption::CaptureRaw)") {
+  DynamicJsonDocument doc(4096);
+  StaticJsonDocument<256> paths;
+
+  SECTION("captures a member") {
+    paths["payload"] = true;
+
+    DeserializationError err = deserializeJson(
+        doc, "{\"id\":1,\"payload\":{\"a\" : [1, 2.50]}}",
+        DeserializationOption::CaptureRaw(paths));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["id"] == 1);
+    REQUIRE(doc["payload"].is<JsonObject>() == false);
+    REQUIRE(doc.memoryUsage() ==
+            JSON_OBJECT_SIZE(2) + 3 + 8 + 18);  // keys and raw text
+
+    std::string output;
+    serializeJson(doc, output);
+    REQUIRE(output == "{\"id\":1,\"payload\":{\"a\" : [1, 2.50]}}");
+  }
+
+  SECTION("captures scalars") {
+    paths["s"] = true;
+    paths["n"] = true;
+    paths["b"] = true;
+
+    deserializeJson(doc, "{\"s\":\"\\u00e9\",\"n\":1e3,\"b\":false}",
+                    DeserializationOption::CaptureRaw(paths));
+
+    REQUIRE(doc.as<std::string>() ==
+            "{\"s\":\"\\u00e9\",\"n\":1e3,\"b\":false}");
+  }
+
+  SECTION("wildcard") {
+    paths["*"]["data"] = true;
+
+    deserializeJson(doc, "{\"x\":{\"data\":[ 1 ],\"y\":2}}",
+                    DeserializationOption::CaptureRaw(paths));
+
+    REQUIRE(doc["x"]["y"] == 2);
+    REQUIRE(doc.as<std::string>() == "{\"x\":{\"data\":[ 1 ],\"y\":2}}");
+  }
+
+  SECTION("array elements") {
+    paths["items"][0]["body"] = true;
+
+    deserializeJson(
+        doc, "{\"items\":[{\"id\":1,\"body\":{}},{\"id\":2,\"body\":[]}]}",
+        DeserializationOption::CaptureRaw(paths));
+
+    REQUIRE(doc["items"][1]["id"] == 2);
+    REQUIRE(doc["items"][1]["body"].is<JsonArray>() == false);
+    REQUIRE(doc["items"][1]["body"].as<std::string>() == "[]");
+  }
+
+  SECTION("mutable input links the raw values") {
+    char input[] = "{\"payload\":[1,2]}";
+    paths["payload"] = true;
+
+    deserializeJson(doc, input, DeserializationOption::CaptureRaw(paths));
+
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1));
+    REQUIRE(doc.as<std::string>() == "{\"payload\":[1,2]}");
+  }
+
+  SECTION("stream") {
+    std::istringstream input("{\"payload\":{\"a\":1},\"id\":2}");
+    paths["payload"] = true;
+
+    deserializeJson(doc, input, DeserializationOption::CaptureRaw(paths));
+
+    REQUIRE(doc.as<std::string>() == "{\"payload\":{\"a\":1},\"id\":2}");
+  }
+
+  SECTION("incomplete input") {
+    paths["payload"] = true;
+
+    DeserializationError err = deserializeJson(
+        doc, "{\"payload\":[1,", DeserializationOption::CaptureRaw(paths));
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("raw value doesn't fit") {
+    StaticJsonDocument<JSON_OBJECT_SIZE(1) + 10> small;
+    paths["payload"] = true;
+
+    DeserializationError err =
+        deserializeJson(small, "{\"payload\":[1,2,3,4,5,6]}",
+                        DeserializationOption::CaptureRaw(paths));
+
+    REQUIRE(err == DeserializationError::NoMemory);
+  }
+}
@@ -0,0 +1,199 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+TEST_CASE("extractJson(input, pointer, JsonVariant)") {
+  StaticJsonDocument<128> doc;
+  const char* input =
+      "{\"header\":{\"type\":\"order\",\"id\":42},"
+      "\"items\":[1,[2,3],{\"a/b\":true,\"m~n\":null}]}";
+
+  SECTION("object member") {
+    DeserializationError err = extractJson(input, "/header/type", doc);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "order");
+    REQUIRE(doc.memoryUsage() == 6);
+  }
+
+  SECTION("array element") {
+    DeserializationError err = extractJson(input, "/items/1/0", doc);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<int>() == 2);
+    REQUIRE(doc.memoryUsage() == 0);
+  }
+
+  SECTION("nested container") {
+    DeserializationError err = extractJson(input, "/items/1", doc);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[2,3]");
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2));
+  }
+
+  SECTION("escaped tokens") {
+    REQUIRE(extractJson(input, "/items/2/a~1b", doc) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.as<bool>() == true);
+  }
+
+  SECTION("empty pointer targets the whole document") {
+    DeserializationError err = extractJson("[1,2]", "", doc);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[1,2]");
+  }
+
+  SECTION("missing member") {
+    doc.set(666);
+
+    DeserializationError err = extractJson(input, "/header/name", doc);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.isNull());
+  }
+
+  SECTION("index out of range") {
+    REQUIRE(extractJson(input, "/items/3", doc) == DeserializationError::Ok);
+    REQUIRE(doc.isNull());
+  }
+
+  SECTION("leading zero in index") {
+    REQUIRE(extractJson(input, "/items/01", doc) == DeserializationError::Ok);
+    REQUIRE(doc.isNull());
+  }
+
+  SECTION("invalid pointer") {
+    REQUIRE(extractJson(input, "header", doc) == DeserializationError::Ok);
+    REQUIRE(doc.isNull());
+  }
+
+  SECTION("stops reading after the target") {
+    DeserializationError err =
+        extractJson("{\"a\":{\"b\":1},\"c\":!!garbage!!", "/a/b", doc);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<int>() == 1);
+  }
+
+  SECTION("leaves the stream after the target") {
+    std::istringstream stream("{\"a\":[1,2],\"b\":3}");
+
+    DeserializationError err = extractJson(stream, "/a", doc);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[1,2]");
+    REQUIRE(stream.get() == ',');
+  }
+
+  SECTION("invalid input before the target") {
+    DeserializationError err = extractJson("{\"a\":!,\"b\":1}", "/b", doc);
+
+    REQUIRE(err == DeserializationError::InvalidInput);
+  }
+
+  SECTION("incomplete input") {
+    DeserializationError err = extractJson("{\"a\":[1,", "/a/1", doc);
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("nesting limit") {
+    DeserializationError err = extractJson(
+        "[[[1]]]", "/0/0/0", doc, DeserializationOption::NestingLimit(2));
+
+    REQUIRE(err == DeserializationError::TooDeep);
+  }
+
+  SECTION("bounded input") {
+    DeserializationError err = extractJson("[1,2][3]", 5, "/1", doc);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<int>() == 2);
+  }
+
+  SECTION("into a member of another document") {
+    DynamicJsonDocument doc2(1024);
+    doc2["id"] = 1;
+
+    DeserializationError err =
+        extractJson(input, "/header", doc2["header"].to<JsonVariant>());
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc2.as<std::string>() ==
+            "{\"id\":1,\"header\":{\"type\":\"order\",\"id\":42}}");
+  }
+
+  SECTION("unbound variant") {
+    DeserializationError err = extractJson(input, "/header", JsonVariant());
+
+    REQUIRE(err == DeserializationError::NoMemory);
+  }
+}
+
+TEST_CASE("extractJson(input, pointer, T&)") {
+  const char* input = "{\"header\":{\"type\":\"order\",\"id\":42}}";
+
+  SECTION("int") {
+    int id = 0;
+
+    DeserializationError err = extractJson(input, "/header/id", id);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(id == 42);
+  }
+
+  SECTION("std::string") {
+    std::string type;
+
+    DeserializationError err = extractJson(input, "/header/type", type);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(type == "order");
+  }
+
+  SECTION("std::string from a stream") {
+    std::istringstream stream(input);
+    std::string type;
+
+    DeserializationError err = extractJson(stream, "/header/type", type);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(type == "order");
+  }
+
+  SECTION("mutable input") {
+    char buffer[] = "{\"a\":\"hello\"}";
+    std::string value;
+
+    DeserializationError err = extractJson(buffer, "/a", value);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(value == "hello");
+  }
+
+  SECTION("missing value leaves the target untouched") {
+    int id = 666;
+
+    DeserializationError err = extractJson(input, "/header/nope", id);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(id == 666);
+  }
+
+  SECTION("bounded input") {
+    int value = 0;
+
+    DeserializationError err = extractJson("[1,2][3]", 5, "/1", value);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(value == 2);
+  }
+}
@@ -0,0 +1,187 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+TEST_CASE("JsonExtractionPlan::bind()") {
+  JsonExtractionPlan<3> plan;
+  int a = 0, b = 0, c = 0;
+
+  SECTION("shares common prefixes") {
+    REQUIRE(plan.bind("/x/a", &a) == true);
+    REQUIRE(plan.bind("/x/b", &b) == true);
+    REQUIRE(plan.size() == 2);
+  }
+
+  SECTION("fails when full") {
+    REQUIRE(plan.bind("/x/a", &a) == true);
+    REQUIRE(plan.bind("/y/b", &b) == false);
+  }
+
+  SECTION("a path that doesn't fit leaves the plan unchanged") {
+    REQUIRE(plan.bind("/a", &a) == true);
+    REQUIRE(plan.bind("/x/y/z", &b) == false);
+    REQUIRE(plan.bind("/x", &c) == true);
+    REQUIRE(plan.bind("/y", &b) == true);
+    REQUIRE(plan.size() == 3);
+
+    REQUIRE(extractJson("{\"a\":1,\"x\":2,\"y\":3}", plan) ==
+            DeserializationError::Ok);
+    REQUIRE(a == 1);
+    REQUIRE(b == 3);
+    REQUIRE(c == 2);
+  }
+
+  SECTION("rebinding replaces the destination") {
+    REQUIRE(plan.bind("/a", &a) == true);
+    REQUIRE(plan.bind("/a", &b) == true);
+    REQUIRE(plan.size() == 1);
+
+    REQUIRE(extractJson("{\"a\":1}", plan) == DeserializationError::Ok);
+    REQUIRE(a == 0);
+    REQUIRE(b == 1);
+  }
+
+  SECTION("rejects a path below a bound path") {
+    REQUIRE(plan.bind("/a", &a) == true);
+    REQUIRE(plan.bind("/a/b", &b) == false);
+    REQUIRE(plan.size() == 1);
+
+    REQUIRE(extractJson("{\"a\":1}", plan) == DeserializationError::Ok);
+    REQUIRE(a == 1);
+  }
+
+  SECTION("rejects a path above a bound path") {
+    REQUIRE(plan.bind("/a/b", &b) == true);
+    REQUIRE(plan.bind("/a", &a) == false);
+    REQUIRE(plan.bind("", &c) == false);
+    REQUIRE(plan.size() == 1);
+
+    REQUIRE(extractJson("{\"a\":{\"b\":2}}", plan) ==
+            DeserializationError::Ok);
+    REQUIRE(a == 0);
+    REQUIRE(b == 2);
+  }
+
+  SECTION("rejects invalid paths") {
+    REQUIRE(plan.bind("a", &a) == false);
+    REQUIRE(plan.bind(0, &c) == false);
+    REQUIRE(plan.size() == 0);
+  }
+}
+
+TEST_CASE("extractJson(input, JsonExtractionPlan&)") {
+  JsonExtractionPlan<16> plan;
+  int64_t id = 0;
+  double price = 0;
+  std::string type;
+  bool urgent = false;
+  int second = 0;
+
+  plan.bind("/header/id", &id);
+  plan.bind("/header/type", &type);
+  plan.bind("/body/price", &price);
+  plan.bind("/body/flags/urgent", &urgent);
+  plan.bind("/body/list/1", &second);
+
+  SECTION("extracts all values in one pass") {
+    DeserializationError err = extractJson(
+        "{\"header\":{\"type\":\"order\",\"id\":9007199254740993,"
+        "\"extra\":[1,2,{\"x\":[]}]},"
+        "\"body\":{\"list\":[10,20,30],\"price\":12.5,"
+        "\"flags\":{\"urgent\":true}}}",
+        plan);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(id == 9007199254740993);
+    REQUIRE(type == "order");
+    REQUIRE(price == 12.5);
+    REQUIRE(urgent == true);
+    REQUIRE(second == 20);
+  }
+
+  SECTION("stops reading when all values are extracted") {
+    std::istringstream stream(
+        "{\"header\":{\"id\":1,\"type\":\"t\"},\"body\":{\"price\":2,"
+        "\"flags\":{\"urgent\":true},\"list\":[0,5]},\"tail\":!!");
+
+    DeserializationError err = extractJson(stream, plan);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(second == 5);
+    REQUIRE(stream.get() == '}');  // the ']' was read to terminate the number
+  }
+
+  SECTION("missing and null values leave destinations untouched") {
+    type = "unchanged";
+    price = 42;
+
+    DeserializationError err =
+        extractJson("{\"header\":{\"type\":null},\"body\":{}}", plan);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(type == "unchanged");
+    REQUIRE(price == 42);
+  }
+
+  SECTION("the plan can be reused") {
+    REQUIRE(extractJson("{\"header\":{\"id\":1}}", plan) ==
+            DeserializationError::Ok);
+    REQUIRE(extractJson("{\"header\":{\"id\":2}}", plan) ==
+            DeserializationError::Ok);
+    REQUIRE(id == 2);
+  }
+
+  SECTION("duplicate keys") {
+    REQUIRE(extractJson("{\"header\":{\"id\":1,\"id\":2}}", plan) ==
+            DeserializationError::Ok);
+    REQUIRE(id == 1);
+  }
+
+  SECTION("invalid input") {
+    REQUIRE(extractJson("{\"header\":{\"id\":!}}", plan) ==
+            DeserializationError::InvalidInput);
+  }
+
+  SECTION("incomplete input") {
+    REQUIRE(extractJson("{\"header\":{\"id\":1", plan) ==
+            DeserializationError::IncompleteInput);
+    REQUIRE(id == 1);
+  }
+
+  SECTION("bounded input") {
+    REQUIRE(extractJson("{\"body\":{\"price\":3}}garbage", 21, plan) ==
+            DeserializationError::Ok);
+    REQUIRE(price == 3);
+  }
+
+  SECTION("mutable input") {
+    char input[] = "{\"header\":{\"type\":\"mutable\"}}";
+
+    REQUIRE(extractJson(input, plan) == DeserializationError::Ok);
+    REQUIRE(type == "mutable");
+  }
+
+  SECTION("string longer than the temporary pool") {
+    std::string longString(ARDUINOJSON_EXTRACTION_BUFFER_SIZE, 'x');
+    std::string input = "{\"header\":{\"type\":\"" + longString + "\"}}";
+
+    REQUIRE(extractJson(input, plan) == DeserializationError::NoMemory);
+  }
+}
+
+TEST_CASE("extractJson(input, JsonExtractionPlan&) with a nested array") {
+  JsonExtractionPlan<2> plan;
+  std::string raw;
+
+  plan.bind("/a/b", &raw);
+
+  REQUIRE(extractJson("{\"a\":{\"b\":[1,2]}}", plan) ==
+          DeserializationError::Ok);
+  REQUIRE(raw == "[1,2]");
+}
@@ -0,0 +1,110 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+static const char* const sortedKeys[] = {"humidity", "sensor", "temperature"};
+static const char* const unsortedKeys[] = {"temperature", "humidity",
+                                           "sensor"};
+
+TEST_CASE("deserializeJson(..., KeyDictionary)") {
+  DynamicJsonDocument doc(4096);
+  KeyDictionary dictionary(sortedKeys);
+
+  SECTION("links the keys found in the dictionary") {
+    DeserializationError err = deserializeJson(
+        doc, "{\"sensor\":\"A\",\"other\":1,\"temperature\":21}", dictionary);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() ==
+            "{\"sensor\":\"A\",\"other\":1,\"temperature\":21}");
+    JsonObject obj = doc.as<JsonObject>();
+    JsonObject::iterator it = obj.begin();
+    REQUIRE(it->key().c_str() == sortedKeys[1]);
+    ++it;
+    REQUIRE(it->key().c_str() != sortedKeys[1]);  // "other" is copied
+    REQUIRE(doc.memoryUsage() ==
+            JSON_OBJECT_SIZE(3) + JSON_STRING_SIZE(1) + JSON_STRING_SIZE(5));
+  }
+
+  SECTION("documents share the keys") {
+    DynamicJsonDocument doc2(4096);
+    deserializeJson(doc, "{\"humidity\":1}", dictionary);
+    deserializeJson(doc2, "{\"humidity\":2}", dictionary);
+
+    REQUIRE(doc.as<JsonObject>().begin()->key().c_str() ==
+            doc2.as<JsonObject>().begin()->key().c_str());
+  }
+
+  SECTION("searches an unsorted dictionary") {
+    DeserializationError err = deserializeJson(
+        doc, "{\"sensor\":\"A\",\"humidity\":2}", KeyDictionary(unsortedKeys));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<JsonObject>().begin()->key().c_str() == unsortedKeys[2]);
+    REQUIRE(doc["humidity"] == 2);
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(2) + JSON_STRING_SIZE(1));
+  }
+
+  SECTION("compares the whole key") {
+    deserializeJson(doc, "{\"sens\":1,\"sensors\":2,\"sensor\\u0000\":3}",
+                    dictionary);
+
+    JsonObject obj = doc.as<JsonObject>();
+    for (JsonPair kv : obj)
+      REQUIRE(kv.key().c_str() != sortedKeys[1]);
+    REQUIRE(obj.size() == 3);
+  }
+
+  SECTION("mutable input") {
+    char input[] = "{\"humidity\":1,\"other\":2}";
+
+    DeserializationError err = deserializeJson(doc, input, dictionary);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<JsonObject>().begin()->key().c_str() == sortedKeys[0]);
+    REQUIRE(doc["other"] == 2);
+  }
+
+  SECTION("works with a filter") {
+    StaticJsonDocument<64> filter;
+    filter["sensor"] = true;
+
+    DeserializationError err =
+        deserializeJson(doc, "{\"sensor\":\"A\",\"humidity\":2}", dictionary,
+                        DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"sensor\":\"A\"}");
+  }
+}
+
+TEST_CASE("KeyDictionary::find()") {
+  KeyDictionary sorted(sortedKeys);
+  KeyDictionary unsorted(unsortedKeys);
+
+  SECTION("returns the key") {
+    REQUIRE(sorted.find("sensor", 6) == sortedKeys[1]);
+    REQUIRE(unsorted.find("sensor", 6) == unsortedKeys[2]);
+    REQUIRE(sorted.find("humidity", 8) == sortedKeys[0]);
+    REQUIRE(sorted.find("temperature", 11) == sortedKeys[2]);
+  }
+
+  SECTION("returns null when the key is missing") {
+    REQUIRE(sorted.find("sens", 4) == 0);
+    REQUIRE(sorted.find("sensors", 7) == 0);
+    REQUIRE(sorted.find("sensor\0", 7) == 0);
+    REQUIRE(sorted.find("zzz", 3) == 0);
+    REQUIRE(sorted.find("aaa", 3) == 0);
+    REQUIRE(unsorted.find("sens", 4) == 0);
+    REQUIRE(KeyDictionary().find("sensor", 6) == 0);
+  }
+
+  SECTION("only uses the first n characters") {
+    REQUIRE(sorted.find("sensors", 6) == sortedKeys[1]);
+  }
+}
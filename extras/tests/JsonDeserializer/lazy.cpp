@@ -0,0 +1,199 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+TEST_CASE("deserializeJson(DeserializationOption::Lazy)") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("stores nested containers verbatim") {
+    DeserializationError err =
+        deserializeJson(doc, "{\"a\":{\"b\":[1, 2]},\"c\":3,\"d\":\"e\"}",
+                        DeserializationOption::Lazy(1));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<JsonVariantConst>()["c"] == 3);
+    REQUIRE(doc.as<JsonVariantConst>()["d"] == "e");
+    REQUIRE(doc.as<JsonVariantConst>()["a"].isNull() == false);
+    REQUIRE(doc.as<JsonVariantConst>()["a"]["b"].isNull() == true);
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(3) + 3 * 2 + 13 + 2);
+  }
+
+  SECTION("serializes unresolved values verbatim") {
+    deserializeJson(doc, "{\"a\":{\"b\":[1, 2]},\"c\":3}",
+                    DeserializationOption::Lazy(1));
+
+    std::string output;
+    serializeJson(doc, output);
+
+    REQUIRE(output == "{\"a\":{\"b\":[1, 2]},\"c\":3}");
+  }
+
+  SECTION("parses a subtree on first access") {
+    deserializeJson(doc, "{\"a\":{\"b\":[1,2]},\"c\":[3]}",
+                    DeserializationOption::Lazy(1));
+
+    REQUIRE(doc["a"]["b"][1] == 2);
+
+    std::string output;
+    serializeJson(doc, output);
+    REQUIRE(output == "{\"a\":{\"b\":[1,2]},\"c\":[3]}");
+    REQUIRE(doc.as<JsonVariantConst>()["a"]["b"][0] == 1);
+    REQUIRE(doc.as<JsonVariantConst>()["c"][0].isNull() == true);
+  }
+
+  SECTION("as<JsonObject>() and as<JsonArray>()") {
+    deserializeJson(doc, "[{\"x\":1},[2]]", DeserializationOption::Lazy(1));
+
+    REQUIRE(doc[0].is<JsonObject>() == true);
+    REQUIRE(doc[0].as<JsonObject>()["x"] == 1);
+    REQUIRE(doc[1].as<JsonArray>().size() == 1);
+  }
+
+  SECTION("modifies a subtree") {
+    deserializeJson(doc, "{\"a\":{\"b\":1}}", DeserializationOption::Lazy(1));
+
+    doc["a"]["c"] = 2;
+
+    REQUIRE(doc.as<std::string>() == "{\"a\":{\"b\":1,\"c\":2}}");
+  }
+
+  SECTION("depth") {
+    deserializeJson(doc, "{\"a\":{\"b\":{\"c\":1}}}",
+                    DeserializationOption::Lazy(2));
+
+    REQUIRE(doc.as<JsonVariantConst>()["a"]["b"].isNull() == false);
+    REQUIRE(doc.as<JsonVariantConst>()["a"]["b"]["c"].isNull() == true);
+    REQUIRE(doc["a"]["b"]["c"] == 1);
+  }
+
+  SECTION("depth 0 defers the root") {
+    deserializeJson(doc, "{\"a\":1}", DeserializationOption::Lazy(0));
+
+    const JsonDocument& cdoc = doc;
+    REQUIRE(cdoc["a"].isNull() == true);
+    REQUIRE(doc["a"] == 1);
+  }
+
+  SECTION("read accessors") {
+    deserializeJson(doc, "{\"a\":[1,2,3],\"b\":{\"c\":4}}",
+                    DeserializationOption::Lazy(1));
+
+    REQUIRE(doc["a"].size() == 3);
+    REQUIRE(doc["a"].is<JsonArrayConst>() == true);
+    REQUIRE(doc["b"].containsKey("c") == true);
+
+    JsonVariantConst b = doc["b"];
+    REQUIRE(b["c"] == 4);
+  }
+
+  SECTION("add()") {
+    deserializeJson(doc, "{\"a\":[1]}", DeserializationOption::Lazy(1));
+
+    JsonVariant a = doc["a"];
+    a.add(2);
+
+    REQUIRE(doc.as<std::string>() == "{\"a\":[1,2]}");
+  }
+
+  SECTION("mutable input") {
+    char input[] = "{\"a\":{\"b\":\"hello\"},\"c\":\"world\"}";
+
+    deserializeJson(doc, input, DeserializationOption::Lazy(1));
+
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(2));
+    REQUIRE(doc["c"] == "world");
+    REQUIRE(doc["a"]["b"] == "hello");
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(2) + JSON_OBJECT_SIZE(1));
+  }
+
+  SECTION("stream") {
+    std::istringstream input("{\"a\":[\"x\",{\"y\":true}]}");
+
+    deserializeJson(doc, input, DeserializationOption::Lazy(1));
+
+    REQUIRE(doc["a"][1]["y"] == true);
+  }
+
+  SECTION("invalid input in a deferred value") {
+    // like filtered-out values, deferred values are only checked superficially
+    DeserializationError err =
+        deserializeJson(doc, "{\"a\":[1,]}", DeserializationOption::Lazy(1));
+    REQUIRE(err == DeserializationError::Ok);
+
+    REQUIRE(doc["a"].is<JsonArray>() == false);
+    REQUIRE(doc["a"].isNull() == true);
+  }
+
+  SECTION("incomplete input in a deferred value") {
+    DeserializationError err =
+        deserializeJson(doc, "{\"a\":[1,", DeserializationOption::Lazy(1));
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("nesting limit applies to deferred values") {
+    DeserializationError err =
+        deserializeJson(doc, "{\"a\":[[1]]}", DeserializationOption::Lazy(1),
+                        DeserializationOption::NestingLimit(2));
+
+    REQUIRE(err == DeserializationError::TooDeep);
+  }
+
+  SECTION("deferred values honor a nesting limit above the default") {
+    std::string input = "{\"a\":" + std::string(20, '[') + "1" +
+                        std::string(20, ']') + "}";
+
+    DeserializationError err =
+        deserializeJson(doc, input, DeserializationOption::Lazy(1),
+                        DeserializationOption::NestingLimit(21));
+    REQUIRE(err == DeserializationError::Ok);
+
+    REQUIRE(doc["a"].nesting() == 20);
+  }
+
+  SECTION("copy to another document") {
+    deserializeJson(doc, "{\"a\":{\"b\":1}}", DeserializationOption::Lazy(1));
+    DynamicJsonDocument doc2(4096);
+
+    doc2.set(doc);
+    doc.clear();
+
+    REQUIRE(doc2["a"]["b"] == 1);
+  }
+
+  SECTION("shrinkToFit()") {
+    deserializeJson(doc, std::string("{\"a\":{\"b\":\"c\"}}"),
+                    DeserializationOption::Lazy(1));
+
+    doc.shrinkToFit();
+
+    REQUIRE(doc.as<std::string>() == "{\"a\":{\"b\":\"c\"}}");
+  }
+}
+
+TEST_CASE("deserializeJson(DeserializationOption::Lazy) with a small pool") {
+  StaticJsonDocument<JSON_OBJECT_SIZE(1) + 12> doc;
+
+  SECTION("text doesn't fit") {
+    DeserializationError err = deserializeJson(
+        doc, "{\"a\":{\"b\":123456789}}", DeserializationOption::Lazy(1));
+
+    REQUIRE(err == DeserializationError::NoMemory);
+  }
+
+  SECTION("resolution doesn't fit") {
+    DeserializationError err =
+        deserializeJson(doc, "{\"a\":[1]}", DeserializationOption::Lazy(1));
+    REQUIRE(err == DeserializationError::Ok);
+
+    REQUIRE(doc["a"][0].isNull() == true);
+    REQUIRE(doc["a"].isNull() == true);
+    REQUIRE(doc.overflowed() == true);
+  }
+}
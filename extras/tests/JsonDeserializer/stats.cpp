@@ -0,0 +1,99 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+static unsigned long fakeTime = 0;
+
+static unsigned long fakeClock() {
+  return ++fakeTime;
+}
+
+TEST_CASE("deserializeJson(DeserializationStats*)") {
+  DynamicJsonDocument doc(4096);
+  DeserializationStats stats;
+
+  SECTION("counts slots, strings, and depth") {
+    DeserializationError err = deserializeJson(
+        doc, "{\"a\":[\"x\",\"x\",{\"b\":[]}],\"c\":1.5}", &stats);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(stats.bytesRead == 32);
+    REQUIRE(stats.slots == 6);
+    REQUIRE(stats.stringBytes == 8);
+    REQUIRE(stats.dedupMisses == 4);
+    REQUIRE(stats.dedupHits == 1);
+    REQUIRE(stats.maxDepth == 4);
+    REQUIRE(stats.bytesSkipped == 0);
+    REQUIRE(stats.stringBytes + JSON_ARRAY_SIZE(stats.slots) ==
+            doc.memoryUsage());
+  }
+
+  SECTION("counts bytes skipped by the filter") {
+    StaticJsonDocument<64> filter;
+    filter["a"] = true;
+
+    DeserializationError err =
+        deserializeJson(doc, "{\"a\":1,\"b\":[1,2,3],\"c\":\"hello\"}",
+                        DeserializationOption::Filter(filter), &stats);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":1}");
+    REQUIRE(stats.bytesSkipped == 14);
+    REQUIRE(stats.slots == 1);
+  }
+
+  SECTION("accepts the options in any order") {
+    DeserializationError err = deserializeJson(
+        doc, "[[1]]", &stats, DeserializationOption::NestingLimit(1));
+
+    REQUIRE(err == DeserializationError::TooDeep);
+    REQUIRE(stats.bytesRead == 2);
+  }
+
+  SECTION("mutable input doesn't copy strings") {
+    char input[] = "[\"hello\",\"world\"]";
+
+    deserializeJson(doc, input, &stats);
+
+    REQUIRE(stats.stringBytes == 0);
+    REQUIRE(stats.dedupMisses == 0);
+    REQUIRE(stats.slots == 2);
+  }
+
+  SECTION("doesn't count what's after the document") {
+    std::istringstream input("[1,2] ");
+
+    deserializeJson(doc, input, &stats);
+
+    REQUIRE(stats.bytesRead == 5);
+  }
+
+  SECTION("measures time with the clock") {
+    DeserializationStats timedStats(fakeClock);
+
+    deserializeJson(doc, "{\"a\":1,\"b\":2}", &timedStats);
+
+    REQUIRE(timedStats.stringTime == 2);
+    REQUIRE(timedStats.numberTime == 2);
+  }
+
+  SECTION("without clock, times are zero") {
+    deserializeJson(doc, "{\"a\":1}", &stats);
+
+    REQUIRE(stats.stringTime == 0);
+    REQUIRE(stats.numberTime == 0);
+  }
+
+  SECTION("resets the stats") {
+    deserializeJson(doc, "[1,2,3]", &stats);
+    deserializeJson(doc, "[1]", &stats);
+
+    REQUIRE(stats.slots == 1);
+  }
+}
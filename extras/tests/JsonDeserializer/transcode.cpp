@@ -0,0 +1,145 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+static std::string viaDocument(const char* json) {
+  DynamicJsonDocument doc(4096);
+  REQUIRE(deserializeJson(doc, json) == DeserializationError::Ok);
+  std::string msgpack;
+  serializeMsgPack(doc, msgpack);
+  return msgpack;
+}
+
+static void checkTranscode(const char* json) {
+  std::string output;
+
+  DeserializationError err = transcodeJsonToMsgPack(json, output);
+
+  CAPTURE(json);
+  REQUIRE(err == DeserializationError::Ok);
+  REQUIRE(output == viaDocument(json));
+}
+
+TEST_CASE("transcodeJsonToMsgPack()") {
+  SECTION("values") {
+    checkTranscode("null");
+    checkTranscode("true");
+    checkTranscode("false");
+    checkTranscode("42");
+    checkTranscode("-129");
+    checkTranscode("3.14");
+    checkTranscode("\"hello\"");
+  }
+
+  SECTION("arrays and objects") {
+    checkTranscode("[]");
+    checkTranscode("{}");
+    checkTranscode("[1,[2,[3]],{\"a\":[]}]");
+    checkTranscode("{\"a\":1,\"b\":{\"c\":[true,null]},\"d\":\"e\"}");
+    checkTranscode(" [ 1 , 2 ] ");
+    checkTranscode("{'single':'quotes',unquoted:1}");
+  }
+
+  SECTION("array 16") {
+    checkTranscode("[0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15]");
+  }
+
+  SECTION("map 16") {
+    checkTranscode(
+        "{\"a\":0,\"b\":1,\"c\":2,\"d\":3,\"e\":4,\"f\":5,\"g\":6,\"h\":7,"
+        "\"i\":8,\"j\":9,\"k\":10,\"l\":11,\"m\":12,\"n\":13,\"o\":14,"
+        "\"p\":15}");
+  }
+
+  SECTION("escaped strings") {
+    checkTranscode("[\"a\\\"b\",\"\\u00e9\",\"]\",\"}\",\",\"]");
+  }
+
+  SECTION("writes the expected bytes") {
+    std::string output;
+
+    REQUIRE(transcodeJsonToMsgPack("{\"hello\":[1,\"x\"]}", output) ==
+            DeserializationError::Ok);
+
+    REQUIRE(output == "\x81\xA5hello\x92\x01\xA1x");
+  }
+
+  SECTION("bounded input") {
+    std::string output;
+
+    REQUIRE(transcodeJsonToMsgPack("[1,2]garbage", 5, output) ==
+            DeserializationError::Ok);
+
+    REQUIRE(output == "\x92\x01\x02");
+  }
+
+  SECTION("std::string input") {
+    std::string input = "[\"a\",\"b\"]";
+    std::string output;
+
+    REQUIRE(transcodeJsonToMsgPack(input, output) == DeserializationError::Ok);
+
+    REQUIRE(output == "\x92\xA1" "a\xA1" "b");
+  }
+
+  SECTION("strings longer than the temporary pool") {
+    std::string longString(ARDUINOJSON_TRANSCODING_BUFFER_SIZE, 'x');
+    std::string input = "[\"" + longString + "\"]";
+    std::string output;
+
+    REQUIRE(transcodeJsonToMsgPack(input, output) ==
+            DeserializationError::NoMemory);
+  }
+
+  SECTION("mutable input has no limit on strings") {
+    std::string longString(ARDUINOJSON_TRANSCODING_BUFFER_SIZE, 'x');
+    std::string json = "[\"" + longString + "\"]";
+    std::string expected = viaDocument(json.c_str());
+    std::string output;
+
+    REQUIRE(transcodeJsonToMsgPack(&json[0], output) ==
+            DeserializationError::Ok);
+
+    REQUIRE(output == expected);
+  }
+
+  SECTION("empty input") {
+    std::string output;
+
+    REQUIRE(transcodeJsonToMsgPack("", output) ==
+            DeserializationError::EmptyInput);
+  }
+
+  SECTION("invalid input") {
+    std::string output;
+
+    REQUIRE(transcodeJsonToMsgPack("[1;2]", output) ==
+            DeserializationError::InvalidInput);
+    REQUIRE(transcodeJsonToMsgPack("{\"a\" 1}", output) ==
+            DeserializationError::InvalidInput);
+  }
+
+  SECTION("incomplete input") {
+    std::string output;
+
+    REQUIRE(transcodeJsonToMsgPack("[1,{\"a\":2}", output) ==
+            DeserializationError::IncompleteInput);
+    REQUIRE(output.empty());  // the first array couldn't be counted
+  }
+
+  SECTION("nesting limit") {
+    std::string output;
+
+    REQUIRE(transcodeJsonToMsgPack("[[1]]", output,
+                                   DeserializationOption::NestingLimit(1)) ==
+            DeserializationError::TooDeep);
+    REQUIRE(transcodeJsonToMsgPack("[[1]]", output,
+                                   DeserializationOption::NestingLimit(2)) ==
+            DeserializationError::Ok);
+  }
+}
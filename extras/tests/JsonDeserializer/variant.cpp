@@ -0,0 +1,115 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+TEST_CASE("deserializeJson(JsonVariant)") {
+  DynamicJsonDocument doc(4096);
+  doc["version"] = 1;
+
+  SECTION("parses into a new member") {
+    DeserializationError err =
+        deserializeJson(doc["sessions"]["42"], "{\"user\":\"bob\"}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() ==
+            "{\"version\":1,\"sessions\":{\"42\":{\"user\":\"bob\"}}}");
+  }
+
+  SECTION("merges objects") {
+    doc["config"]["a"] = 1;
+    doc["config"]["b"]["x"] = 2;
+    doc["config"]["c"] = 3;
+
+    DeserializationError err = deserializeJson(
+        doc["config"], "{\"a\":10,\"b\":{\"y\":20},\"c\":null,\"d\":[4]}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["config"].as<std::string>() ==
+            "{\"a\":10,\"b\":{\"x\":2,\"y\":20},\"c\":null,\"d\":[4]}");
+  }
+
+  SECTION("replaces other values") {
+    doc["list"].add(1);
+
+    DeserializationError err = deserializeJson(doc["list"], "[2,3]");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["list"].as<std::string>() == "[2,3]");
+  }
+
+  SECTION("replaces an object with a value") {
+    doc["config"]["a"] = 1;
+
+    deserializeJson(doc["config"], "42");
+
+    REQUIRE(doc.as<std::string>() == "{\"version\":1,\"config\":42}");
+  }
+
+  SECTION("JsonVariant") {
+    JsonVariant variant = doc["config"].to<JsonObject>();
+
+    deserializeJson(variant, "{\"a\":1}");
+
+    REQUIRE(doc.as<std::string>() == "{\"version\":1,\"config\":{\"a\":1}}");
+  }
+
+  SECTION("array element") {
+    doc["list"].add(1);
+    doc["list"].add(2);
+
+    deserializeJson(doc["list"][1], "{\"b\":true}");
+
+    REQUIRE(doc["list"].as<std::string>() == "[1,{\"b\":true}]");
+  }
+
+  SECTION("mutable input") {
+    char input[] = "{\"name\":\"alice\"}";
+
+    deserializeJson(doc["user"], input);
+
+    REQUIRE(doc["user"]["name"] == "alice");
+    REQUIRE(doc["user"]["name"].as<const char*>() == input + 5);
+  }
+
+  SECTION("input size") {
+    deserializeJson(doc["list"], "[1,2]garbage", 5);
+
+    REQUIRE(doc["list"].as<std::string>() == "[1,2]");
+  }
+
+  SECTION("with a filter") {
+    StaticJsonDocument<64> filter;
+    filter["a"] = true;
+
+    deserializeJson(doc["config"], "{\"a\":1,\"b\":2}",
+                    DeserializationOption::Filter(filter));
+
+    REQUIRE(doc["config"].as<std::string>() == "{\"a\":1}");
+  }
+
+  SECTION("unbound variant") {
+    DeserializationError err = deserializeJson(JsonVariant(), "[1]");
+
+    REQUIRE(err == DeserializationError::NoMemory);
+  }
+
+  SECTION("doesn't fit") {
+    StaticJsonDocument<JSON_OBJECT_SIZE(1)> small;
+
+    DeserializationError err = deserializeJson(small["a"], "[1]");
+
+    REQUIRE(err == DeserializationError::NoMemory);
+  }
+
+  SECTION("invalid input keeps what was parsed") {
+    DeserializationError err = deserializeJson(doc["config"], "{\"a\":1,!}");
+
+    REQUIRE(err == DeserializationError::InvalidInput);
+    REQUIRE(doc["config"]["a"] == 1);
+  }
+}
@@ -171,9 +171,33 @@ TEST_CASE("BasicJsonDocument") {
 
       bool result = doc.garbageCollect();
 
+      REQUIRE(result == true);  // compacted in place
+      REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1) + 8);
+      REQUIRE(doc.capacity() == 4096);
+      REQUIRE(doc.as<std::string>() == "{\"dancing\":2}");
+    }
+  }
+
+  SECTION("garbageCollect() when the pool is full") {
+    BasicJsonDocument<ControllableAllocator> doc(JSON_OBJECT_SIZE(2) + 16);
+    deserializeJson(doc, "{\"blanket\":1,\"dancing\":2}");
+    doc.remove("blanket");
+
+    SECTION("when allocation succeeds") {
+      bool result = doc.garbageCollect();
+
+      REQUIRE(result == true);
+      REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1) + 8);
+      REQUIRE(doc.as<std::string>() == "{\"dancing\":2}");
+    }
+
+    SECTION("when allocation fails") {
+      doc.allocator().disable();
+
+      bool result = doc.garbageCollect();
+
       REQUIRE(result == false);
       REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(2) + 16);
-      REQUIRE(doc.capacity() == 4096);
       REQUIRE(doc.as<std::string>() == "{\"dancing\":2}");
     }
   }
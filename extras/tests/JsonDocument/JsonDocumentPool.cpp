@@ -0,0 +1,107 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <atomic>
+#include <catch.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("JsonDocumentPool") {
+  JsonDocumentPool pool(1024);
+
+  SECTION("acquire() returns an empty document of the next capacity class") {
+    DynamicJsonDocument* doc = pool.acquire(1500);
+
+    REQUIRE(doc != 0);
+    REQUIRE(doc->capacity() == 2048);
+    REQUIRE(doc->isNull());
+    pool.release(doc);
+  }
+
+  SECTION("acquire() returns null above the largest class") {
+    REQUIRE(pool.acquire(size_t(1024) << 16) == 0);
+    REQUIRE(pool.highWaterMark() == 0);
+  }
+
+  SECTION("release() clears the document and keeps it") {
+    DynamicJsonDocument* doc1 = pool.acquire(1024);
+    doc1->add(std::string("hello"));
+    pool.release(doc1);
+
+    REQUIRE(pool.idleCount() == 1);
+
+    DynamicJsonDocument* doc2 = pool.acquire(1000);
+
+    REQUIRE(doc2 == doc1);
+    REQUIRE(doc2->isNull());
+    REQUIRE(doc2->memoryUsage() == 0);
+    REQUIRE(pool.idleCount() == 0);
+    pool.release(doc2);
+  }
+
+  SECTION("The classes don't share their documents") {
+    pool.release(pool.acquire(1024));
+
+    DynamicJsonDocument* doc = pool.acquire(2048);
+
+    REQUIRE(doc->capacity() == 2048);
+    REQUIRE(pool.idleCount() == 1);
+    pool.release(doc);
+  }
+
+  SECTION("release() drops a document that shrank") {
+    DynamicJsonDocument* doc = pool.acquire(1024);
+    doc->shrinkToFit();
+
+    pool.release(doc);
+
+    REQUIRE(pool.idleCount() == 0);
+  }
+
+  SECTION("trim() keeps the documents up to the high-water mark") {
+    DynamicJsonDocument* docs[3];
+    for (int i = 0; i < 3; i++)
+      docs[i] = pool.acquire(1024);
+    for (int i = 0; i < 3; i++)
+      pool.release(docs[i]);
+    REQUIRE(pool.highWaterMark() == 3);
+
+    pool.trim();
+
+    REQUIRE(pool.idleCount() == 3);  // used in the last period
+    REQUIRE(pool.highWaterMark() == 0);
+
+    pool.release(pool.acquire(1024));
+    pool.trim();
+
+    REQUIRE(pool.idleCount() == 1);
+  }
+
+  SECTION("Can be shared between threads") {
+    std::atomic<int> errors(0);  // Catch's assertions aren't thread-safe
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+      threads.push_back(std::thread([&pool, &errors, t]() {
+        for (int i = 0; i < 1000; i++) {
+          DynamicJsonDocument* doc = pool.acquire(1024);
+          if (!doc->isNull())
+            errors++;
+          (*doc)["thread"] = t;
+          (*doc)["iteration"] = i;
+          if ((*doc)["thread"] != t || (*doc)["iteration"] != i)
+            errors++;
+          pool.release(doc);
+        }
+      }));
+    }
+    for (size_t t = 0; t < threads.size(); t++)
+      threads[t].join();
+
+    REQUIRE(errors == 0);
+    REQUIRE(pool.idleCount() <= 4);
+    REQUIRE(pool.highWaterMark() <= 4);
+  }
+}
@@ -0,0 +1,101 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("JsonDocument::garbageCollect()") {
+  StaticJsonDocument<1024> doc;
+
+  SECTION("Keeps the nested values") {
+    deserializeJson(doc,
+                    "{\"garbage\":[1,2,3],\"config\":{\"name\":\"hello\","
+                    "\"values\":[1,\"two\",[3]],\"empty\":{}},\"more\":\"x\"}");
+    doc.remove("garbage");
+    doc["config"]["values"].remove(0);
+    size_t expected = doc.memoryUsage();
+
+    doc.garbageCollect();
+
+    REQUIRE(doc.memoryUsage() < expected);
+    REQUIRE(doc.as<std::string>() ==
+            "{\"config\":{\"name\":\"hello\",\"values\":[\"two\",[3]],"
+            "\"empty\":{}},\"more\":\"x\"}");
+  }
+
+  SECTION("Reclaims the replaced strings") {
+    doc["a"] = std::string("first value");
+    doc["b"] = std::string("second value");
+    doc["a"] = std::string("third value");
+
+    doc.garbageCollect();
+
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(2) + JSON_STRING_SIZE(12) +
+                                     JSON_STRING_SIZE(11));
+    REQUIRE(doc["a"] == "third value");
+    REQUIRE(doc["b"] == "second value");
+  }
+
+  SECTION("Keeps the binary values intact") {
+    const char input[] = "\x82\xA1\x61\xC4\x01\x01\xA1\x62\xC4\x03\x00\x42\x00";
+    deserializeMsgPack(doc, input, sizeof(input) - 1);
+    doc.remove("a");
+
+    doc.garbageCollect();
+
+    JsonBinary b = doc["b"].as<JsonBinary>();
+    REQUIRE(b.size() == 3);
+    REQUIRE(b.data()[0] == 0x00);
+    REQUIRE(b.data()[1] == 0x42);
+    REQUIRE(b.data()[2] == 0x00);
+  }
+
+  SECTION("Doesn't touch the values of another document") {
+    StaticJsonDocument<256> other;
+    other["hello"] = std::string("world");
+    doc["garbage"] = std::string("garbage");
+    doc.remove("garbage");
+    doc["other"].shallowCopy(other);
+
+    doc.garbageCollect();
+
+    REQUIRE(doc.as<std::string>() == "{\"other\":{\"hello\":\"world\"}}");
+    REQUIRE(other.as<std::string>() == "{\"hello\":\"world\"}");
+  }
+
+  SECTION("Relocates the values shared by shallowCopy() once") {
+    doc["garbage"] = std::string("garbage");
+    doc["a"]["b"] = std::string("c");
+    doc.remove("garbage");
+    doc["d"].shallowCopy(doc["a"]);
+
+    doc.garbageCollect();
+
+    REQUIRE(doc.as<std::string>() ==
+            "{\"a\":{\"b\":\"c\"},\"d\":{\"b\":\"c\"}}");
+  }
+
+  SECTION("Can add values afterwards") {
+    deserializeJson(doc, "[\"a\",\"b\",\"c\"]");
+    doc.remove(1);
+    doc.garbageCollect();
+
+    doc.add(std::string("d"));
+
+    REQUIRE(doc.as<std::string>() == "[\"a\",\"c\",\"d\"]");
+  }
+
+  SECTION("Copies the document when the pool is full") {
+    StaticJsonDocument<JSON_ARRAY_SIZE(2)> small;
+    small.add(1);
+    small.add(2);
+    small.remove(0);
+
+    small.garbageCollect();
+
+    REQUIRE(small.memoryUsage() == JSON_ARRAY_SIZE(1));
+    REQUIRE(small.as<std::string>() == "[2]");
+  }
+}
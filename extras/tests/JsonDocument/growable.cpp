@@ -0,0 +1,204 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <string.h>  // memcpy
+#include <algorithm>
+#include <catch.hpp>
+#include <string>
+#include <utility>
+
+// Allocates the blocks in a single arena because the pool requires them to be
+// close to each other, which malloc() doesn't guarantee (e.g., with ASan)
+class ArenaAllocator {
+ public:
+  ArenaAllocator(int& blocks) : blocks_(&blocks), enabled_(true) {}
+
+  void* allocate(size_t n) {
+    static char arena[1024 * 1024];
+    static size_t used = 0;
+    size_t required = sizeof(Header) + n;
+    if (!enabled_ || required > sizeof(arena) - used)
+      return 0;
+    Header* header = reinterpret_cast<Header*>(arena + used);
+    header->size = n;
+    used += (required + 15) & ~size_t(15);
+    ++*blocks_;
+    return header + 1;
+  }
+
+  void deallocate(void*) {
+    --*blocks_;
+  }
+
+  void* reallocate(void* p, size_t n) {
+    void* q = allocate(n);
+    memcpy(q, p, std::min(n, reinterpret_cast<Header*>(p)[-1].size));
+    deallocate(p);
+    return q;
+  }
+
+  void disable() {
+    enabled_ = false;
+  }
+
+ private:
+  struct Header {
+    size_t size;
+    size_t padding;
+  };
+
+  int* blocks_;
+  bool enabled_;
+};
+
+typedef BasicJsonDocument<ArenaAllocator> GrowableDocument;
+
+static std::string makeJson(int n) {
+  std::string json = "[";
+  for (int i = 0; i < n; i++) {
+    if (i)
+      json += ",";
+    json += "{\"id\":" + std::to_string(i) + ",\"name\":\"item" +
+            std::to_string(i) + "\"}";
+  }
+  return json + "]";
+}
+
+TEST_CASE("BasicJsonDocument::setGrowable()") {
+  int blocks = 0;
+  std::string input = makeJson(100);
+
+  SECTION("Disabled by default") {
+    GrowableDocument doc(64, ArenaAllocator(blocks));
+
+    REQUIRE(doc.growable() == false);
+    REQUIRE(deserializeJson(doc, input) == DeserializationError::NoMemory);
+    REQUIRE(blocks == 1);
+  }
+
+  SECTION("Chains blocks when the capacity is exhausted") {
+    GrowableDocument doc(64, ArenaAllocator(blocks));
+    doc.setGrowable(true);
+
+    REQUIRE(deserializeJson(doc, input) == DeserializationError::Ok);
+    REQUIRE(blocks > 1);
+    REQUIRE(doc.capacity() > 64);
+    REQUIRE(doc.memoryUsage() <= doc.capacity());
+    REQUIRE(doc.size() == 100);
+    REQUIRE(doc[99]["name"] == "item99");
+
+    std::string output;
+    serializeJson(doc, output);
+    REQUIRE(output == input);
+  }
+
+  SECTION("Moves a string that doesn't fit in the current block") {
+    GrowableDocument doc(64, ArenaAllocator(blocks));
+    doc.setGrowable(true);
+    std::string value(1000, 'x');
+
+    REQUIRE(deserializeJson(doc, "[\"" + value + "\"]") ==
+            DeserializationError::Ok);
+    REQUIRE(doc[0] == value);
+  }
+
+  SECTION("Grows when adding values") {
+    GrowableDocument doc(64, ArenaAllocator(blocks));
+    doc.setGrowable(true);
+
+    for (int i = 0; i < 100; i++)
+      REQUIRE(doc.add(std::to_string(i)) == true);
+
+    REQUIRE(doc.overflowed() == false);
+    REQUIRE(doc.size() == 100);
+    REQUIRE(doc[42] == "42");
+  }
+
+  SECTION("clear() releases the additional blocks") {
+    GrowableDocument doc(64, ArenaAllocator(blocks));
+    doc.setGrowable(true);
+    deserializeJson(doc, input);
+
+    doc.clear();
+
+    REQUIRE(blocks == 1);
+    REQUIRE(doc.capacity() == 64);
+    REQUIRE(doc.memoryUsage() == 0);
+  }
+
+  SECTION("The destructor releases all the blocks") {
+    {
+      GrowableDocument doc(64, ArenaAllocator(blocks));
+      doc.setGrowable(true);
+      deserializeJson(doc, input);
+    }
+    REQUIRE(blocks == 0);
+  }
+
+  SECTION("shrinkToFit() gathers the blocks") {
+    GrowableDocument doc(64, ArenaAllocator(blocks));
+    doc.setGrowable(true);
+    deserializeJson(doc, input);
+
+    doc.shrinkToFit();
+
+    REQUIRE(blocks == 1);
+    REQUIRE(doc.capacity() - doc.memoryUsage() < 8);  // padding
+    REQUIRE(doc.growable() == true);
+    std::string output;
+    serializeJson(doc, output);
+    REQUIRE(output == input);
+  }
+
+  SECTION("The move constructor transfers the blocks") {
+    GrowableDocument doc1(64, ArenaAllocator(blocks));
+    doc1.setGrowable(true);
+    deserializeJson(doc1, input);
+    int blocksBefore = blocks;
+
+    {
+      GrowableDocument doc2(std::move(doc1));
+
+      REQUIRE(blocks == blocksBefore);
+      REQUIRE(doc2.growable() == true);
+      REQUIRE(doc2[99]["id"] == 99);
+      for (int i = 0; i < 100; i++)
+        doc2.add(i);
+      REQUIRE(doc2.overflowed() == false);
+    }
+    REQUIRE(blocks == 0);
+  }
+
+  SECTION("The copy constructor makes a single block") {
+    GrowableDocument doc1(64, ArenaAllocator(blocks));
+    doc1.setGrowable(true);
+    deserializeJson(doc1, input);
+    int blocksBefore = blocks;
+
+    GrowableDocument doc2(doc1);
+
+    REQUIRE(blocks == blocksBefore + 1);
+    REQUIRE(doc2.growable() == true);
+    REQUIRE(doc2 == doc1);
+  }
+
+  SECTION("Returns NoMemory when the allocator fails") {
+    GrowableDocument doc(64, ArenaAllocator(blocks));
+    doc.setGrowable(true);
+    doc.allocator().disable();
+
+    REQUIRE(deserializeJson(doc, input) == DeserializationError::NoMemory);
+  }
+
+  SECTION("saveSnapshot() requires a single block") {
+    GrowableDocument doc(64, ArenaAllocator(blocks));
+    doc.setGrowable(true);
+    deserializeJson(doc, input);
+
+    REQUIRE(measureSnapshot(doc) == 0);
+    doc.shrinkToFit();
+    REQUIRE(measureSnapshot(doc) > 0);
+  }
+}
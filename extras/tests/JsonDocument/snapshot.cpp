@@ -0,0 +1,137 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+TEST_CASE("saveSnapshot() / loadSnapshot()") {
+  DynamicJsonDocument doc(4096);
+  deserializeJson(doc,
+                  "{\"name\":\"sensor\",\"values\":[1,-2,1.5,null],"
+                  "\"nested\":{\"ok\":true,\"text\":\"hello\"}}");
+
+  SECTION("round trip through a std::string") {
+    std::string snapshot;
+    size_t n = saveSnapshot(doc, snapshot);
+
+    REQUIRE(n == snapshot.size());
+    REQUIRE(n == measureSnapshot(doc));
+
+    DynamicJsonDocument doc2(doc.memoryUsage());
+    DeserializationError err = loadSnapshot(doc2, snapshot);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc2 == doc);
+    REQUIRE(doc2.memoryUsage() == doc.memoryUsage());
+    REQUIRE(doc2["nested"]["text"].as<std::string>() == "hello");
+  }
+
+  SECTION("the loaded document can be modified") {
+    std::string snapshot;
+    saveSnapshot(doc, snapshot);
+
+    DynamicJsonDocument doc2(4096);
+    loadSnapshot(doc2, snapshot);
+    doc2["values"].add(42);
+    doc2["extra"] = std::string("world");
+
+    REQUIRE(doc2["values"].size() == 5);
+    REQUIRE(doc2["values"][4] == 42);
+    REQUIRE(doc2["extra"] == "world");
+    REQUIRE(doc2["name"] == "sensor");
+  }
+
+  SECTION("round trip through a buffer and a stream") {
+    char buffer[1024];
+    size_t n = saveSnapshot(doc, buffer, sizeof(buffer));
+    REQUIRE(n > 0);
+
+    std::istringstream stream(std::string(buffer, n));
+    StaticJsonDocument<1024> doc2;
+    DeserializationError err = loadSnapshot(doc2, stream);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc2 == doc);
+  }
+
+  SECTION("buffer too small") {
+    char buffer[32];
+    REQUIRE(saveSnapshot(doc, buffer, sizeof(buffer)) == 0);
+  }
+
+  SECTION("linked strings can't be relocated") {
+    doc["linked"] = "literal";
+    std::string snapshot;
+    REQUIRE(saveSnapshot(doc, snapshot) == 0);
+    REQUIRE(measureSnapshot(doc) == 0);
+  }
+
+  SECTION("document too small") {
+    std::string snapshot;
+    saveSnapshot(doc, snapshot);
+
+    DynamicJsonDocument doc2(doc.memoryUsage() - 8);  // padded to 8
+    REQUIRE(loadSnapshot(doc2, snapshot) == DeserializationError::NoMemory);
+    REQUIRE(doc2.isNull());
+  }
+
+  SECTION("empty input") {
+    REQUIRE(loadSnapshot(doc, "", 0) == DeserializationError::EmptyInput);
+    REQUIRE(doc.isNull());
+  }
+
+  SECTION("truncated snapshot") {
+    std::string snapshot;
+    saveSnapshot(doc, snapshot);
+
+    DynamicJsonDocument doc2(4096);
+    for (size_t i = 1; i < snapshot.size(); i += 7) {
+      REQUIRE(loadSnapshot(doc2, snapshot.data(), i) ==
+              DeserializationError::IncompleteInput);
+      REQUIRE(doc2.isNull());
+    }
+  }
+
+  SECTION("wrong magic or layout") {
+    std::string snapshot;
+    saveSnapshot(doc, snapshot);
+
+    DynamicJsonDocument doc2(4096);
+    std::string wrongMagic = snapshot;
+    wrongMagic[0] = 'X';
+    REQUIRE(loadSnapshot(doc2, wrongMagic) ==
+            DeserializationError::InvalidInput);
+
+    std::string wrongByteOrder = snapshot;
+    wrongByteOrder[5] = '?';
+    REQUIRE(loadSnapshot(doc2, wrongByteOrder) ==
+            DeserializationError::InvalidInput);
+
+    std::string wrongVersion = snapshot;
+    wrongVersion[4] = 1;
+    REQUIRE(loadSnapshot(doc2, wrongVersion) ==
+            DeserializationError::InvalidInput);
+  }
+
+  SECTION("the header records the slot layout") {
+    std::string snapshot;
+    saveSnapshot(doc, snapshot);
+
+    REQUIRE(snapshot[10] == ARDUINOJSON_SLOT_OFFSET_SIZE);
+    REQUIRE(snapshot[11] == (ARDUINOJSON_STORE_KEY_SIZE |
+                             ARDUINOJSON_COMPACT_SLOTS << 1 |
+                             ARDUINOJSON_INLINE_SHORT_STRINGS << 2 |
+                             ARDUINOJSON_STORE_COLLECTION_SIZE << 3));
+
+    // e.g., a program that doesn't store the size of the keys
+    std::string wrongSlotFlags = snapshot;
+    wrongSlotFlags[11] ^= 1;
+    DynamicJsonDocument doc2(4096);
+    REQUIRE(loadSnapshot(doc2, wrongSlotFlags) ==
+            DeserializationError::InvalidInput);
+  }
+}
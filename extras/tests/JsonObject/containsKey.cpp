@@ -4,6 +4,7 @@
 
 #include <ArduinoJson.h>
 #include <catch.hpp>
+#include <string>
 
 TEST_CASE("JsonObject::containsKey()") {
   DynamicJsonDocument doc(4096);
@@ -27,6 +28,30 @@ TEST_CASE("JsonObject::containsKey()") {
     REQUIRE(false == obj.containsKey("hello"));
   }
 
+  SECTION("compares the keys of the same size") {
+    obj["world"] = 1;
+
+    REQUIRE(false == obj.containsKey("hellp"));
+    REQUIRE(true == obj.containsKey("world"));
+    REQUIRE(false == obj.containsKey("hell"));
+    REQUIRE(false == obj.containsKey("hello!"));
+  }
+
+  SECTION("keys longer than 255 characters") {
+    std::string key1(300, 'a');
+    std::string key2(300, 'a');
+    key2[299] = 'b';
+    obj[key1] = 1;
+
+    REQUIRE(false == obj.containsKey(key2));
+    REQUIRE(false == obj.containsKey(std::string(299, 'a')));
+    REQUIRE(true == obj.containsKey(key1));
+    REQUIRE(true == obj.containsKey(key1.c_str()));
+    JsonObject::iterator it = obj.begin();
+    ++it;
+    REQUIRE(it->key().size() == 300);
+  }
+
 #ifdef HAS_VARIABLE_LENGTH_ARRAY
   SECTION("key is a VLA") {
     size_t i = 16;
@@ -79,4 +79,20 @@ TEST_CASE("JsonObject::remove()") {
     JsonObject unboundObject;
     unboundObject.remove(unboundObject.begin());
   }
+
+  SECTION("Reuses the memory of the removed members") {
+    StaticJsonDocument<JSON_OBJECT_SIZE(3)> doc2;
+    JsonObject obj2 = doc2.to<JsonObject>();
+    obj2["a"] = 0;
+    obj2["b"]["c"] = 1;
+
+    for (int i = 0; i < 10; i++) {
+      obj2.remove("b");
+      REQUIRE(obj2["b"]["c"].set(i) == true);
+    }
+
+    REQUIRE(doc2.overflowed() == false);
+    serializeJson(obj2, result);
+    REQUIRE("{\"a\":0,\"b\":{\"c\":9}}" == result);
+  }
 }
@@ -101,6 +101,22 @@ TEST_CASE("serializeJson(JsonVariant)") {
     check(true, "true");
   }
 
+  SECTION("JsonBinary") {
+    check(JsonBinary("", 0), "\"\"");
+    check(JsonBinary("f", 1), "\"Zg==\"");
+    check(JsonBinary("fo", 2), "\"Zm8=\"");
+    check(JsonBinary("foo", 3), "\"Zm9v\"");
+    check(JsonBinary("foobar", 6), "\"Zm9vYmFy\"");
+    check(JsonBinary("\xFB\xFF\xBF", 3), "\"+/+/\"");
+    check(JsonBinary(1, "foo", 3), "\"Zm9v\"");
+  }
+
+  SECTION("long JsonBinary") {
+    std::string data(100, '\0');
+    check(JsonBinary(data.data(), data.size()),
+          "\"" + std::string(132, 'A') + "AA==\"");
+  }
+
   SECTION("OneFalse") {
     check(false, "false");
   }
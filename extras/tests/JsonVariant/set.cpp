@@ -170,3 +170,83 @@ TEST_CASE("JsonVariant::set(DynamicJsonDocument)") {
   serializeJson(doc2, json);
   REQUIRE(json == "{\"hello\":\"world\"}");
 }
+
+TEST_CASE("JsonVariant::set() reuses the memory of the previous value") {
+  StaticJsonDocument<JSON_OBJECT_SIZE(3)> doc;
+
+  SECTION("Replace an object") {
+    for (int i = 0; i < 10; i++) {
+      JsonObject obj = doc["a"].to<JsonObject>();
+      obj["b"] = i;
+      obj["c"] = i;
+    }
+
+    REQUIRE(doc.overflowed() == false);
+    REQUIRE(doc["a"]["c"] == 9);
+  }
+
+  SECTION("Replace a value by one of its members") {
+    StaticJsonDocument<JSON_OBJECT_SIZE(4)> doc2;
+    doc2["a"]["b"]["c"] = 1;
+
+    doc2["a"] = doc2["a"]["b"];
+
+    REQUIRE(doc2["a"]["c"] == 1);
+    REQUIRE(doc2["x"].set(2) == true);
+    REQUIRE(doc2["y"].set(3) == true);
+    REQUIRE(doc2.overflowed() == false);
+  }
+
+  SECTION("clear()") {
+    doc["a"]["b"] = 1;
+
+    for (int i = 0; i < 10; i++) {
+      doc["a"].clear();
+      doc["a"]["b"] = i;
+    }
+
+    REQUIRE(doc.overflowed() == false);
+    REQUIRE(doc["a"]["b"] == 9);
+  }
+}
+
+TEST_CASE("JsonVariant::set() with the same variant") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("Assign a member to itself") {
+    doc["a"] = "hello world";
+    doc["b"] = std::string("hello world");
+
+    doc["a"] = doc["a"];
+    doc["b"] = doc["b"];
+
+    REQUIRE(doc["a"] == "hello world");
+    REQUIRE(doc["b"] == "hello world");
+  }
+
+  SECTION("Assign a JsonVariant to its own member") {
+    doc["b"] = std::string("hello world");
+    JsonVariant v = doc["b"];
+
+    doc["b"] = v;
+
+    REQUIRE(doc["b"] == "hello world");
+  }
+
+  SECTION("Assign a JsonVariantConst to its own member") {
+    JsonObject obj = doc.to<JsonObject>();
+    obj["a"]["b"] = std::string("c");
+
+    obj["a"] = obj["a"].as<JsonVariantConst>();
+
+    REQUIRE(obj["a"]["b"] == "c");
+  }
+
+  SECTION("Assign an element to itself") {
+    doc[0] = std::string("hello world");
+
+    doc[0] = doc[0];
+
+    REQUIRE(doc[0] == "hello world");
+  }
+}
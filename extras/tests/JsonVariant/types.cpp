@@ -128,6 +128,31 @@ TEST_CASE("JsonVariant set()/get()") {
   }
 #endif
 
+  SECTION("JsonBinary") {
+    DynamicJsonDocument doc(4096);
+    JsonVariant variant = doc.to<JsonVariant>();
+    uint8_t data[] = {0, 1, 2};
+
+    variant.set(JsonBinary(data, 3));
+    data[0] = 42;  // the bytes were copied
+
+    REQUIRE(variant.is<JsonBinary>());
+    REQUIRE(variant.is<const char*>() == false);
+    REQUIRE(variant.as<JsonBinary>() == JsonBinary("\0\1\2", 3));
+    REQUIRE(variant == JsonBinary("\0\1\2", 3));
+    REQUIRE(variant != JsonBinary(1, "\0\1\2", 3));
+    REQUIRE(doc.memoryUsage() == 4);
+
+    variant.set(JsonBinary(-1, data, 2));
+    REQUIRE(variant.as<JsonBinary>().isExt());
+    REQUIRE(variant.as<JsonBinary>().extType() == -1);
+    REQUIRE(variant.as<JsonBinary>().size() == 2);
+
+    DynamicJsonDocument copy(doc);
+    REQUIRE(copy.as<JsonBinary>() == JsonBinary(-1, "\x2A\1", 2));
+    REQUIRE(copy.as<JsonVariant>() == variant);
+  }
+
   SECTION("CanStoreObject") {
     DynamicJsonDocument doc(4096);
     JsonObject object = doc.to<JsonObject>();
@@ -47,4 +47,29 @@ TEST_CASE("MemoryPool::allocVariant()") {
 
     REQUIRE(pool.allocVariant() == 0);
   }
+
+  SECTION("Reuses the freed slots") {
+    MemoryPool pool(buffer, 2 * sizeof(VariantSlot));
+    VariantSlot* s1 = pool.allocVariant();
+    VariantSlot* s2 = pool.allocVariant();
+
+    pool.freeVariant(s1);
+    pool.freeVariant(s2);
+
+    REQUIRE(pool.allocVariant() == s2);
+    REQUIRE(pool.allocVariant() == s1);
+    REQUIRE(pool.allocVariant() == 0);
+    REQUIRE(pool.size() == 2 * sizeof(VariantSlot));
+  }
+
+  SECTION("clear() forgets the freed slots") {
+    MemoryPool pool(buffer, sizeof(buffer));
+    VariantSlot* s1 = pool.allocVariant();
+    pool.freeVariant(s1);
+
+    pool.clear();
+
+    REQUIRE(pool.allocVariant() == s1);
+    REQUIRE(pool.size() == sizeof(VariantSlot));
+  }
 }
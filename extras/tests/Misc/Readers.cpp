@@ -51,6 +51,17 @@ TEST_CASE("Reader<std::istringstream>") {
   }
 }
 
+TEST_CASE("skipInput(Reader<std::istringstream>)") {
+  std::istringstream src("ABCDEF");
+  Reader<std::istringstream> reader(src);
+
+  REQUIRE(ReaderHasSkip<Reader<std::istringstream>>::value == true);
+  REQUIRE(skipInput(reader, 4) == 4);
+  REQUIRE(reader.read() == 'E');
+  REQUIRE(skipInput(reader, 4) == 1);
+  REQUIRE(reader.read() == -1);
+}
+
 TEST_CASE("BoundedReader<const char*>") {
   SECTION("read") {
     BoundedReader<const char*> reader("\x01\xFF", 2);
@@ -89,6 +100,15 @@ TEST_CASE("BoundedReader<const char*>") {
   }
 }
 
+TEST_CASE("skipInput(BoundedReader<const char*>)") {
+  BoundedReader<const char*> reader("ABCDEF", 6);
+
+  REQUIRE(skipInput(reader, 4) == 4);
+  REQUIRE(reader.read() == 'E');
+  REQUIRE(skipInput(reader, 4) == 1);
+  REQUIRE(reader.read() == -1);
+}
+
 TEST_CASE("Reader<const char*>") {
   SECTION("read()") {
     Reader<const char*> reader("\x01\xFF\x00\x12");
@@ -127,6 +147,13 @@ TEST_CASE("Reader<const char*>") {
   }
 }
 
+TEST_CASE("skipInput(Reader<const char*>)") {
+  Reader<const char*> reader("ABCDEF");
+
+  REQUIRE(skipInput(reader, 4) == 4);
+  REQUIRE(reader.read() == 'E');
+}
+
 TEST_CASE("IteratorReader") {
   SECTION("read()") {
     std::string src("\x01\xFF");
@@ -168,6 +195,16 @@ TEST_CASE("IteratorReader") {
   }
 }
 
+TEST_CASE("skipInput(IteratorReader)") {
+  std::string src("ABCDEF");
+  IteratorReader<std::string::const_iterator> reader(src.begin(), src.end());
+
+  REQUIRE(skipInput(reader, 4) == 4);
+  REQUIRE(reader.read() == 'E');
+  REQUIRE(skipInput(reader, 4) == 1);
+  REQUIRE(reader.read() == -1);
+}
+
 class StreamStub : public Stream {
  public:
   StreamStub(const char* s) : stream_(s) {}
@@ -225,3 +262,15 @@ TEST_CASE("Reader<Stream>") {
     REQUIRE(buffer[6] == 'g');
   }
 }
+
+TEST_CASE("skipInput(Reader<Stream>)") {
+  // Stream can't seek, so skipInput() reads the bytes
+  StreamStub src("ABCDEF");
+  Reader<StreamStub> reader(src);
+
+  REQUIRE(ReaderHasSkip<Reader<StreamStub>>::value == false);
+  REQUIRE(skipInput(reader, 4) == 4);
+  REQUIRE(reader.read() == 'E');
+  REQUIRE(skipInput(reader, 4) == 1);
+  REQUIRE(reader.read() == -1);
+}
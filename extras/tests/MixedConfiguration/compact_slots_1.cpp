@@ -0,0 +1,119 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_COMPACT_SLOTS 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_COMPACT_SLOTS == 1") {
+  SECTION("slots are smaller on 64-bit platforms") {
+    if (sizeof(void*) == 8)
+      CHECK(JSON_ARRAY_SIZE(1) == 24);
+    CHECK(JSON_ARRAY_SIZE(1) <= 4 * sizeof(void*));
+  }
+
+  SECTION("linked key") {
+    StaticJsonDocument<256> doc;
+    const char* key = "hello";
+
+    doc[key] = 1;
+
+    CHECK(doc.memoryUsage() == JSON_OBJECT_SIZE(1) + sizeof(char*));
+    CHECK(doc.as<JsonObject>().begin()->key().c_str() == key);
+    CHECK(doc.as<std::string>() == "{\"hello\":1}");
+  }
+
+  SECTION("owned key") {
+    StaticJsonDocument<256> doc;
+
+    doc[std::string("hello")] = 1;
+
+    CHECK(doc.memoryUsage() == JSON_OBJECT_SIZE(1) + JSON_STRING_SIZE(5));
+    CHECK(doc.as<std::string>() == "{\"hello\":1}");
+  }
+
+  SECTION("no room for the pointer to a linked key") {
+    StaticJsonDocument<JSON_OBJECT_SIZE(1)> doc;
+
+    doc["hello"] = 1;
+
+    CHECK(doc.overflowed() == true);
+    CHECK(doc.as<std::string>() == "{}");
+  }
+
+  SECTION("deserializeJson()") {
+    DynamicJsonDocument doc(1024);
+
+    DeserializationError err =
+        deserializeJson(doc, "{\"a\":{\"b\":[1,{\"c\":\"d\"}]},\"e\":true}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    CHECK(doc["a"]["b"][1]["c"] == "d");
+    CHECK(doc.as<std::string>() == "{\"a\":{\"b\":[1,{\"c\":\"d\"}]},\"e\":true}");
+  }
+
+  SECTION("shrinkToFit()") {
+    DynamicJsonDocument doc(1024);
+    doc["linked"] = 1;
+    doc[std::string("owned")] = std::string("value");
+    doc["nested"]["key"] = 2;
+
+    doc.shrinkToFit();
+
+    CHECK(doc.as<std::string>() ==
+          "{\"linked\":1,\"owned\":\"value\",\"nested\":{\"key\":2}}");
+  }
+
+  SECTION("garbageCollect()") {
+    StaticJsonDocument<1024> doc;
+    doc[std::string("garbage")] = std::string("garbage");
+    doc["linked"] = 1;
+    doc[std::string("owned")] = std::string("value");
+    doc["nested"]["key"] = 2;
+    doc.remove("garbage");
+
+    doc.garbageCollect();
+
+    CHECK(doc.memoryUsage() == JSON_OBJECT_SIZE(4) + 3 * sizeof(char*) +
+                                   JSON_STRING_SIZE(5) + JSON_STRING_SIZE(5));
+    CHECK(doc.as<std::string>() ==
+          "{\"linked\":1,\"owned\":\"value\",\"nested\":{\"key\":2}}");
+  }
+
+  SECTION("copy") {
+    DynamicJsonDocument doc(1024);
+    doc["linked"] = 1;
+    doc[std::string("owned")] = 2;
+
+    DynamicJsonDocument copy(doc);
+
+    CHECK(copy.as<std::string>() == "{\"linked\":1,\"owned\":2}");
+  }
+
+  SECTION("remove() and add") {
+    StaticJsonDocument<1024> doc;
+    doc["a"] = 1;
+    doc[std::string("b")] = 2;
+    doc.remove("a");
+    doc.remove("b");
+
+    doc["c"] = 3;
+    doc[std::string("d")] = 4;
+
+    CHECK(doc.as<std::string>() == "{\"c\":3,\"d\":4}");
+  }
+
+  SECTION("more elements than a 16-bit offset can count") {
+    DynamicJsonDocument doc(JSON_ARRAY_SIZE(70000));
+    JsonArray array = doc.to<JsonArray>();
+    for (int i = 0; i < 70000; i++)
+      array.add(i);
+
+    CHECK(array.size() == 70000);
+    CHECK(array[69999] == 69999);
+    CHECK(doc.overflowed() == false);
+  }
+}
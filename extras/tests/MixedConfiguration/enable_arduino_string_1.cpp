@@ -0,0 +1,29 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_ENABLE_ARDUINO_STRING 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_ENABLE_ARDUINO_STRING == 1") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("as<String>()") {
+    doc["hello"] = "world";
+
+    REQUIRE(doc["hello"].as<String>() == "world");
+  }
+
+  SECTION("as<String>() with ZeroCopy") {
+    // the strings are not null-terminated
+    const char input[] = "\x92\xA2hi\xA5world";
+
+    deserializeMsgPack(doc, input, sizeof(input) - 1,
+                       DeserializationOption::ZeroCopy());
+
+    REQUIRE(doc[0].as<String>() == "hi");
+    REQUIRE(doc[1].as<String>() == "world");
+  }
+}
@@ -119,5 +119,31 @@ TEST_CASE("ARDUINOJSON_ENABLE_STRING_DEDUPLICATION = 0") {
         CHECK(key1 != key2);
       }
     }
+
+    SECTION("Reuses the memory of the replaced strings") {
+      doc["value"] = std::string("example");
+      // the previous value is released after the copy
+      doc["value"] = std::string("example");
+      size_t memoryUsage = doc.memoryUsage();
+
+      for (int i = 0; i < 10; i++)
+        doc["value"] = std::string("example");
+
+      CHECK(doc.memoryUsage() == memoryUsage);
+      CHECK(doc["value"] == "example");
+    }
+
+    SECTION("Reuses the memory of the removed keys") {
+      doc[std::string("example")] = 1;
+      size_t memoryUsage = doc.memoryUsage();
+
+      for (int i = 0; i < 10; i++) {
+        doc.remove("example");
+        doc[std::string("example")] = 1;
+      }
+
+      CHECK(doc.memoryUsage() == memoryUsage);
+      CHECK(doc["example"] == 1);
+    }
   }
 }
@@ -118,5 +118,16 @@ TEST_CASE("ARDUINOJSON_ENABLE_STRING_DEDUPLICATION = 1") {
         CHECK(key1 == key2);
       }
     }
+
+    SECTION("Doesn't reuse the strings, since they may be shared") {
+      doc[0] = std::string("example");
+      doc[1] = std::string("example");
+
+      doc.remove(0);
+      doc.add(std::string("other"));
+
+      CHECK(doc[0] == "example");
+      CHECK(doc[1] == "other");
+    }
   }
 }
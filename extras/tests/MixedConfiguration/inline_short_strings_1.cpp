@@ -0,0 +1,131 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_INLINE_SHORT_STRINGS 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+static const size_t capacity = sizeof(char*) + sizeof(size_t) - 1;
+
+TEST_CASE("ARDUINOJSON_INLINE_SHORT_STRINGS == 1") {
+  StaticJsonDocument<1024> doc;
+  std::string longest(capacity, 'x');
+  std::string tooLong(capacity + 1, 'x');
+
+  SECTION("short string") {
+    doc.add(std::string("ok"));
+
+    CHECK(doc.memoryUsage() == JSON_ARRAY_SIZE(1));
+    CHECK(doc[0] == "ok");
+    CHECK(doc[0].as<JsonString>().size() == 2);
+    CHECK(doc[0].is<const char*>() == true);
+    CHECK(doc[0].is<float>() == false);
+  }
+
+  SECTION("the pointer is stable") {
+    doc.add(std::string("ok"));
+    const char* s = doc[0];
+
+    doc.add(std::string("GET"));
+
+    CHECK(doc[0].as<const char*>() == s);
+    CHECK(std::string(s) == "ok");
+  }
+
+  SECTION("empty string") {
+    doc.add(std::string());
+
+    CHECK(doc.memoryUsage() == JSON_ARRAY_SIZE(1));
+    CHECK(doc[0] == "");
+  }
+
+  SECTION("longest inline string") {
+    doc.add(longest);
+
+    CHECK(doc.memoryUsage() == JSON_ARRAY_SIZE(1));
+    CHECK(doc[0].as<std::string>() == longest);
+  }
+
+  SECTION("string too long") {
+    doc.add(tooLong);
+
+    CHECK(doc.memoryUsage() == JSON_ARRAY_SIZE(1) + tooLong.size() + 1);
+    CHECK(doc[0].as<std::string>() == tooLong);
+  }
+
+  SECTION("string with a null character") {
+    doc.add(std::string("a\0b", 3));
+
+    CHECK(doc[0].as<JsonString>().size() == 3);
+    CHECK(doc[0].as<std::string>() == std::string("a\0b", 3));
+  }
+
+  SECTION("linked strings stay linked") {
+    const char* s = "ok";
+    doc.add(s);
+
+    CHECK(doc[0].as<const char*>() == s);
+  }
+
+  SECTION("number in a string") {
+    doc.add(std::string("42"));
+
+    CHECK(doc[0].as<int>() == 42);
+    CHECK(doc[0].as<float>() == 42.0f);
+  }
+
+  SECTION("deserializeJson()") {
+    deserializeJson(doc, "{\"status\":\"ok\",\"region\":\"eu-west-1\"}");
+
+    CHECK(doc.memoryUsage() == JSON_OBJECT_SIZE(2) + 7 + 7);
+    CHECK(doc["status"] == "ok");
+    CHECK(doc["region"] == "eu-west-1");
+  }
+
+  SECTION("deserializeJson() with a mutable input") {
+    char input[] = "[\"ok\"]";
+    deserializeJson(doc, input);
+
+    const char* s = doc[0];
+    CHECK(s >= input);
+    CHECK(s < input + sizeof(input));
+  }
+
+  SECTION("deserializeMsgPack()") {
+    std::string input("\x92\xA2ok\xA3GET", 8);
+    deserializeMsgPack(doc, input);
+
+    CHECK(doc.memoryUsage() == JSON_ARRAY_SIZE(2));
+    CHECK(doc.as<std::string>() == "[\"ok\",\"GET\"]");
+  }
+
+  SECTION("serialize") {
+    doc["method"] = std::string("GET");
+
+    CHECK(doc.as<std::string>() == "{\"method\":\"GET\"}");
+  }
+
+  SECTION("copy") {
+    doc["method"] = std::string("GET");
+
+    DynamicJsonDocument copy(doc);
+
+    CHECK(copy.memoryUsage() == doc.memoryUsage());
+    CHECK(copy["method"] == "GET");
+  }
+
+  SECTION("garbageCollect()") {
+    doc.add(std::string("ok"));
+    doc.add(tooLong);
+    doc.add(std::string("GET"));
+    doc.remove(1);
+
+    doc.garbageCollect();
+
+    CHECK(doc.memoryUsage() == JSON_ARRAY_SIZE(2));
+    CHECK(doc.as<std::string>() == "[\"ok\",\"GET\"]");
+  }
+}
@@ -0,0 +1,92 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+// like on 8-bit platforms
+#define ARDUINOJSON_SLOT_OFFSET_SIZE 1
+#define ARDUINOJSON_STORE_COLLECTION_SIZE 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_SLOT_OFFSET_SIZE == 1") {
+  // more slots than an offset can address
+  DynamicJsonDocument doc(JSON_ARRAY_SIZE(400));
+
+  SECTION("more elements than an offset can count") {
+    JsonArray array = doc.to<JsonArray>();
+    for (int i = 0; i < 300; i++)
+      REQUIRE(array.add(i) == true);
+
+    REQUIRE(array.size() == 300);
+    REQUIRE(array[299] == 299);
+    REQUIRE(doc.overflowed() == false);
+
+    std::string json, msgpack;
+    serializeJson(doc, json);
+    serializeMsgPack(doc, msgpack);
+    DynamicJsonDocument doc2(JSON_ARRAY_SIZE(400));
+
+    REQUIRE(deserializeJson(doc2, json) == DeserializationError::Ok);
+    REQUIRE(doc2.size() == 300);
+    REQUIRE(doc2[299] == 299);
+
+    REQUIRE(deserializeMsgPack(doc2, msgpack) == DeserializationError::Ok);
+    REQUIRE(doc2.size() == 300);
+    REQUIRE(doc2[299] == 299);
+  }
+
+  SECTION("subscript beyond the range of an offset") {
+    doc[299] = 299;
+    doc[255] = 255;
+
+    REQUIRE(doc.size() == 300);
+    REQUIRE(doc[255] == 255);
+    REQUIRE(doc[299] == 299);
+    REQUIRE(doc.as<JsonArrayConst>()[298].isNull() == true);
+    REQUIRE(doc.as<JsonArrayConst>()[300].isUnbound() == true);
+  }
+
+  SECTION("subscript beyond the capacity") {
+    doc[500] = 1;
+
+    REQUIRE(doc.overflowed() == true);
+    REQUIRE(doc.size() == 400);
+  }
+
+  SECTION("fails when the link to the new slot is out of range") {
+    JsonArray outer = doc.to<JsonArray>();
+    outer.add(1);
+    JsonArray inner = outer.createNestedArray();
+    for (int i = 0; i < 200; i++)
+      inner.add(i);
+
+    REQUIRE(outer.add(2) == false);
+    REQUIRE(doc.overflowed() == true);
+    REQUIRE(outer.size() == 2);
+    REQUIRE(inner.size() == 200);
+  }
+
+  SECTION("tail farther than an offset can reach") {
+    JsonArray array = doc.to<JsonArray>();
+    for (int i = 0; i < 300; i++)
+      array.add(i);
+    array.remove(0);
+    array.remove(150);
+    doc.garbageCollect();
+
+    REQUIRE(array.add(300) == true);
+    REQUIRE(array.size() == 299);
+    REQUIRE(array[297] == 299);
+    REQUIRE(array[298] == 300);
+
+    doc.shrinkToFit();
+    doc.remove(297);  // keeps the tail
+
+    REQUIRE(doc.add(301) == true);
+    REQUIRE(doc.size() == 299);
+    REQUIRE(doc[297] == 300);
+    REQUIRE(doc[298] == 301);
+  }
+}
@@ -0,0 +1,32 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+// like on 32-bit platforms
+#define ARDUINOJSON_SLOT_OFFSET_SIZE 2
+#define ARDUINOJSON_STORE_COLLECTION_SIZE 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_SLOT_OFFSET_SIZE == 2") {
+  SECTION("more elements than an offset can count") {
+    DynamicJsonDocument doc(JSON_ARRAY_SIZE(70000));
+    JsonArray array = doc.to<JsonArray>();
+    for (int i = 0; i < 70000; i++)
+      REQUIRE(array.add(i) == true);
+
+    REQUIRE(array.size() == 70000);
+    REQUIRE(array[69999] == 69999);
+    REQUIRE(doc.overflowed() == false);
+
+    std::string msgpack;
+    serializeMsgPack(doc, msgpack);
+    DynamicJsonDocument doc2(JSON_ARRAY_SIZE(70000));
+
+    REQUIRE(deserializeMsgPack(doc2, msgpack) == DeserializationError::Ok);
+    REQUIRE(doc2.size() == 70000);
+    REQUIRE(doc2[69999] == 69999);
+  }
+}
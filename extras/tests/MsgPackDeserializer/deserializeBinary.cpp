@@ -0,0 +1,165 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+static void checkBinary(const char* input, size_t inputSize,
+                        JsonBinary expected, const char* expectedJson) {
+  DynamicJsonDocument doc(4096);
+
+  DeserializationError error = deserializeMsgPack(doc, input, inputSize);
+
+  REQUIRE(error == DeserializationError::Ok);
+  REQUIRE(doc[0].is<JsonBinary>());
+  REQUIRE(doc[0].as<JsonBinary>() == expected);
+  REQUIRE(doc[1] == 42);
+
+  std::string json;
+  serializeJson(doc, json);
+  REQUIRE(json == expectedJson);
+
+  // round-trip
+  std::string msgpack;
+  serializeMsgPack(doc, msgpack);
+  REQUIRE(msgpack == std::string(input, inputSize));
+}
+
+TEST_CASE("deserializeMsgPack() bin and ext") {
+  SECTION("bin 8") {
+    checkBinary("\x92\xc4\x01X\x2A", 5, JsonBinary("X", 1), "[\"WA==\",42]");
+  }
+
+  SECTION("bin 16") {
+    std::string input = std::string("\x92\xc5\x01\x00", 4) +
+                        std::string(256, 'x') + "\x2A";
+    std::string data(256, 'x');
+
+    DynamicJsonDocument doc(4096);
+    REQUIRE(deserializeMsgPack(doc, input) == DeserializationError::Ok);
+    REQUIRE(doc[0] == JsonBinary(data.data(), data.size()));
+    REQUIRE(doc[1] == 42);
+  }
+
+  SECTION("bin 32") {
+    DynamicJsonDocument doc(4096);
+    REQUIRE(deserializeMsgPack(doc, "\x92\xc6\x00\x00\x00\x01X\x2A", 8) ==
+            DeserializationError::Ok);
+    REQUIRE(doc[0] == JsonBinary("X", 1));
+  }
+
+  SECTION("empty bin") {
+    checkBinary("\x92\xc4\x00\x2A", 4, JsonBinary("", 0), "[\"\",42]");
+  }
+
+  SECTION("ext 8") {
+    checkBinary("\x92\xc7\x03\x05\x01\x02\x03\x2A", 8,
+                JsonBinary(5, "\x01\x02\x03", 3), "[\"AQID\",42]");
+  }
+
+  SECTION("ext 16") {
+    DynamicJsonDocument doc(4096);
+    REQUIRE(deserializeMsgPack(doc, "\x92\xc8\x00\x01\x01\x01\x2A", 7) ==
+            DeserializationError::Ok);
+    REQUIRE(doc[0] == JsonBinary(1, "\x01", 1));
+  }
+
+  SECTION("ext 32") {
+    DynamicJsonDocument doc(4096);
+    REQUIRE(deserializeMsgPack(doc, "\x92\xc9\x00\x00\x00\x01\x01\x01\x2A",
+                               9) == DeserializationError::Ok);
+    REQUIRE(doc[0] == JsonBinary(1, "\x01", 1));
+  }
+
+  SECTION("fixext 1") {
+    checkBinary("\x92\xd4\xff\x01\x2A", 5, JsonBinary(-1, "\x01", 1),
+                "[\"AQ==\",42]");
+  }
+
+  SECTION("fixext 2") {
+    checkBinary("\x92\xd5\x01\x01\x02\x2A", 6, JsonBinary(1, "\x01\x02", 2),
+                "[\"AQI=\",42]");
+  }
+
+  SECTION("fixext 4") {
+    checkBinary("\x92\xd6\x01\x01\x02\x03\x04\x2A", 8,
+                JsonBinary(1, "\x01\x02\x03\x04", 4), "[\"AQIDBA==\",42]");
+  }
+
+  SECTION("fixext 8") {
+    checkBinary("\x92\xd7\x01\x01\x02\x03\x04\x05\x06\x07\x08\x2A", 12,
+                JsonBinary(1, "\x01\x02\x03\x04\x05\x06\x07\x08", 8),
+                "[\"AQIDBAUGBwg=\",42]");
+  }
+
+  SECTION("fixext 16") {
+    checkBinary(
+        "\x92\xd8\x01\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A\x0B\x0C\x0D\x0E"
+        "\x0F\x10\x2A",
+        20,
+        JsonBinary(1,
+                   "\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A\x0B\x0C\x0D\x0E"
+                   "\x0F\x10",
+                   16),
+        "[\"AQIDBAUGBwgJCgsMDQ4PEA==\",42]");
+  }
+
+  SECTION("copied to the pool") {
+    DynamicJsonDocument doc(4096);
+
+    deserializeMsgPack(doc, "\xc4\x03\x00\x01\x02", 5);
+
+    REQUIRE(doc.memoryUsage() == 4);
+  }
+
+  SECTION("stays in a mutable input") {
+    DynamicJsonDocument doc(4096);
+    char input[] = "\xc7\x02\x07\x00\x01";
+
+    deserializeMsgPack(doc, input, 5);
+
+    REQUIRE(doc.memoryUsage() == 0);
+    REQUIRE(doc.as<JsonBinary>() == JsonBinary(7, "\x00\x01", 2));
+  }
+
+  SECTION("links the input with DeserializationOption::ZeroCopy") {
+    DynamicJsonDocument doc(4096);
+    const char input[] = "\xc4\x02\x00\x01";
+
+    deserializeMsgPack(doc, input, 4, DeserializationOption::ZeroCopy());
+
+    REQUIRE(doc.memoryUsage() == 0);
+    REQUIRE(doc.as<JsonBinary>().data() ==
+            reinterpret_cast<const uint8_t*>(input + 2));
+  }
+
+  SECTION("filtered out") {
+    DynamicJsonDocument doc(4096);
+    StaticJsonDocument<64> filter;
+    filter["b"] = true;
+
+    deserializeMsgPack(doc, "\x82\xA1" "a" "\xc4\x01X\xA1" "b" "\xd4\x01\x01",
+                       12, DeserializationOption::Filter(filter));
+
+    REQUIRE(doc.as<std::string>() == "{\"b\":\"AQ==\"}");
+  }
+
+  SECTION("incomplete input") {
+    DynamicJsonDocument doc(4096);
+
+    REQUIRE(deserializeMsgPack(doc, "\xc4\x03\x00\x01", 4) ==
+            DeserializationError::IncompleteInput);
+    REQUIRE(deserializeMsgPack(doc, "\xd6\x01\x00", 3) ==
+            DeserializationError::IncompleteInput);
+  }
+
+  SECTION("not enough memory") {
+    StaticJsonDocument<8> doc;
+    std::string input = "\xc4\x10" + std::string(16, 'x');
+
+    REQUIRE(deserializeMsgPack(doc, input) == DeserializationError::NoMemory);
+  }
+}
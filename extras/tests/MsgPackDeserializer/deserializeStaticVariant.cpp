@@ -150,3 +150,48 @@ TEST_CASE("deserializeMsgPack(StaticJsonDocument&)") {
     }
   }
 }
+
+TEST_CASE("deserializeMsgPack() reserves the slots of arrays and maps") {
+  StaticJsonDocument<JSON_ARRAY_SIZE(4)> doc;
+
+  SECTION("fails before reading the elements") {
+    // the elements are missing, but the array can't fit anyway
+    DeserializationError err =
+        deserializeMsgPack(doc, "\xDD\x00\x01\x00\x00", 5);
+
+    REQUIRE(err == DeserializationError::NoMemory);
+    REQUIRE(doc.memoryUsage() == 0);
+  }
+
+  SECTION("fails before reading the members") {
+    DeserializationError err =
+        deserializeMsgPack(doc, "\xDF\x00\x01\x00\x00", 5);
+
+    REQUIRE(err == DeserializationError::NoMemory);
+    REQUIRE(doc.memoryUsage() == 0);
+  }
+
+  SECTION("allocates one slot per element") {
+    DeserializationError err = deserializeMsgPack(doc, "\x93\x01\x02\x03");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[1,2,3]");
+    REQUIRE(doc[1].as<int>() == 2);
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(3));
+  }
+
+  SECTION("keeps the elements read before an error") {
+    DeserializationError err = deserializeMsgPack(doc, "\x93\x01\x02", 3);
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+    REQUIRE(doc.as<std::string>() == "[1,2,null]");
+  }
+
+  SECTION("removes the members without key after an error") {
+    DeserializationError err = deserializeMsgPack(doc, "\x83\xA1H\x01", 4);
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+    REQUIRE(doc.as<std::string>() == "{\"H\":1}");
+    REQUIRE(doc.size() == 1);
+  }
+}
@@ -1133,3 +1133,31 @@ TEST_CASE("Overloads") {
   }
 #endif
 }
+
+TEST_CASE("deserializeMsgPack() skips filtered values in a stream") {
+  StaticJsonDocument<200> filter;
+  filter["id"] = true;
+  DynamicJsonDocument doc(4096);
+
+  SECTION("bin 32") {
+    std::string data(100000, '\0');
+    std::istringstream input(
+        std::string("\x82\xA4" "blob" "\xC6\x00\x01\x86\xA0", 11) + data +
+        "\xA2id\x2A");
+
+    DeserializationError err =
+        deserializeMsgPack(doc, input, DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"id\":42}");
+  }
+
+  SECTION("truncated bin") {
+    std::istringstream input(std::string("\x81\xA4" "blob" "\xC4\x10xx", 10));
+
+    DeserializationError err =
+        deserializeMsgPack(doc, input, DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+}
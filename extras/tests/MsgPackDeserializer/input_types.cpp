@@ -93,3 +93,31 @@ TEST_CASE("deserializeMsgPack(CustomReader)") {
   REQUIRE(doc[0] == "Hello");
   REQUIRE(doc[1] == "world");
 }
+
+TEST_CASE("deserializeMsgPack(const char*, size_t)") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("long string") {
+    std::string input = std::string("\xDA\x01\x00", 3) + std::string(256, 'x');
+
+    DeserializationError err =
+        deserializeMsgPack(doc, input.c_str(), input.size());
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == std::string(256, 'x'));
+  }
+
+  SECTION("truncated string") {
+    DeserializationError err = deserializeMsgPack(doc, "\xA5Hello", 4);
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("string doesn't fit in the pool") {
+    StaticJsonDocument<8> small;
+
+    DeserializationError err = deserializeMsgPack(small, "\xA8Hello!!!", 9);
+
+    REQUIRE(err == DeserializationError::NoMemory);
+  }
+}
@@ -0,0 +1,85 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+static const char* const dictionaryKeys[] = {"temperature", "humidity",
+                                             "sensor"};
+
+TEST_CASE("deserializeMsgPack(..., KeyDictionary)") {
+  DynamicJsonDocument doc(4096);
+  KeyDictionary dictionary(dictionaryKeys);
+
+  SECTION("links the keys to the dictionary") {
+    DeserializationError err = deserializeMsgPack(
+        doc, std::string("\x82\x02\xA1" "A\x00\x15", 6), dictionary);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["sensor"] == "A");
+    REQUIRE(doc["temperature"] == 21);
+    JsonObject obj = doc.as<JsonObject>();
+    REQUIRE(obj.begin()->key().c_str() == dictionaryKeys[2]);
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(2) + JSON_STRING_SIZE(1));
+  }
+
+  SECTION("accepts string keys") {
+    DeserializationError err =
+        deserializeMsgPack(doc, "\x82\xA5other\x01\x01\x02", dictionary);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["other"] == 1);
+    REQUIRE(doc["humidity"] == 2);
+  }
+
+  SECTION("links the string keys found in the dictionary") {
+    DeserializationError err =
+        deserializeMsgPack(doc, "\x81\xA8humidity\x01", dictionary);
+
+    REQUIRE(err == DeserializationError::Ok);
+    JsonObject obj = doc.as<JsonObject>();
+    REQUIRE(obj.begin()->key().c_str() == dictionaryKeys[1]);
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1));
+  }
+
+  SECTION("uint8 and uint16 indexes") {
+    DeserializationError err = deserializeMsgPack(
+        doc, std::string("\x82\xCC\x01\x01\xCD\x00\x02\x02", 8), dictionary);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["humidity"] == 1);
+    REQUIRE(doc["sensor"] == 2);
+  }
+
+  SECTION("index out of range") {
+    DeserializationError err =
+        deserializeMsgPack(doc, "\x81\x03\x01", dictionary);
+
+    REQUIRE(err == DeserializationError::InvalidInput);
+  }
+
+  SECTION("works with a filter") {
+    StaticJsonDocument<64> filter;
+    filter["humidity"] = true;
+
+    DeserializationError err = deserializeMsgPack(
+        doc, std::string("\x82\x00\x01\x01\x02", 5), dictionary,
+        DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"humidity\":2}");
+  }
+
+  SECTION("mutable input") {
+    char input[] = "\x82\x02\xA1" "A\xA5other\x01";
+
+    DeserializationError err = deserializeMsgPack(doc, input, dictionary);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["sensor"] == "A");
+    REQUIRE(doc["other"] == 1);
+  }
+}
@@ -0,0 +1,37 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+TEST_CASE("deserializeMsgPack(DeserializationStats*)") {
+  DynamicJsonDocument doc(4096);
+  DeserializationStats stats;
+
+  SECTION("counts bytes, slots, and strings") {
+    DeserializationError err =
+        deserializeMsgPack(doc, "\x82\xA1x\x92\x01\x02\xA1y\xA1x", &stats);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(stats.bytesRead == 10);
+    REQUIRE(stats.slots == 4);
+    REQUIRE(stats.stringBytes == 4);
+    REQUIRE(stats.dedupMisses == 2);
+    REQUIRE(stats.dedupHits == 1);
+    REQUIRE(stats.maxDepth == 2);
+  }
+
+  SECTION("counts bytes skipped by the filter") {
+    StaticJsonDocument<64> filter;
+    filter["y"] = true;
+
+    DeserializationError err = deserializeMsgPack(
+        doc, "\x82\xA1x\x92\x01\xCD\x01\x02\xA1y\x03",
+        DeserializationOption::Filter(filter), &stats);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"y\":3}");
+    REQUIRE(stats.bytesSkipped == 5);
+  }
+}
@@ -0,0 +1,129 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+static void checkTranscode(const std::string& msgpack,
+                           const std::string& expected) {
+  std::string output;
+
+  DeserializationError err = transcodeMsgPackToJson(msgpack, output);
+
+  CAPTURE(msgpack);
+  REQUIRE(err == DeserializationError::Ok);
+  REQUIRE(output == expected);
+}
+
+TEST_CASE("transcodeMsgPackToJson()") {
+  SECTION("values") {
+    checkTranscode("\xC0", "null");
+    checkTranscode("\xC3", "true");
+    checkTranscode("\x2A", "42");
+    checkTranscode("\xD1\xFF\x7F", "-129");
+    checkTranscode("\xCB\x40\x09\x1E\xB8\x51\xEB\x85\x1F", "3.14");
+    checkTranscode("\xA5hello", "\"hello\"");
+    checkTranscode("\xC4\x03\x01\x02\x03", "\"AQID\"");
+  }
+
+  SECTION("arrays and objects") {
+    checkTranscode("\x90", "[]");
+    checkTranscode("\x80", "{}");
+    checkTranscode("\x93\x01\x92\x02\x91\x03\x81\xA1" "a\x90",
+                   "[1,[2,[3]],{\"a\":[]}]");
+    checkTranscode("\x82\xA1" "a\x01\xA1" "b\x81\xA1" "c\x92\xC3\xC0",
+                   "{\"a\":1,\"b\":{\"c\":[true,null]}}");
+  }
+
+  SECTION("array 16 and map 32") {
+    checkTranscode(std::string("\xDC\x00\x02\x01\x02", 5), "[1,2]");
+    checkTranscode(std::string("\xDF\x00\x00\x00\x01\xA1" "a\x01", 8),
+                   "{\"a\":1}");
+  }
+
+  SECTION("escapes the strings") {
+    checkTranscode("\xA3" "a\"b", "\"a\\\"b\"");
+  }
+
+  SECTION("stream input") {
+    std::istringstream input("\x92\xA1x\x01");
+    std::string output;
+
+    REQUIRE(transcodeMsgPackToJson(input, output) ==
+            DeserializationError::Ok);
+
+    REQUIRE(output == "[\"x\",1]");
+  }
+
+  SECTION("bounded input") {
+    std::string output;
+
+    REQUIRE(transcodeMsgPackToJson("\x91\x01garbage", 2, output) ==
+            DeserializationError::Ok);
+
+    REQUIRE(output == "[1]");
+  }
+
+  SECTION("many strings, each shorter than the temporary pool") {
+    std::string longString(ARDUINOJSON_TRANSCODING_BUFFER_SIZE / 2, 'x');
+    std::string input = "\x94";
+    std::string expected = "[";
+    for (int i = 0; i < 4; i++) {
+      input += "\xD9";
+      input += char(longString.size());
+      input += longString;
+      if (i)
+        expected += ",";
+      expected += "\"" + longString + "\"";
+    }
+    expected += "]";
+
+    checkTranscode(input, expected);
+  }
+
+  SECTION("strings longer than the temporary pool") {
+    std::string input = "\xDA\x01";
+    input += '\0';
+    input += std::string(256, 'x');
+    std::string output;
+
+    REQUIRE(transcodeMsgPackToJson(input, output) ==
+            DeserializationError::NoMemory);
+  }
+
+  SECTION("empty input") {
+    std::string output;
+
+    REQUIRE(transcodeMsgPackToJson("", 0, output) ==
+            DeserializationError::EmptyInput);
+  }
+
+  SECTION("incomplete input") {
+    std::string output;
+
+    REQUIRE(transcodeMsgPackToJson("\x92\x01", 2, output) ==
+            DeserializationError::IncompleteInput);
+  }
+
+  SECTION("invalid key") {
+    std::string output;
+
+    REQUIRE(transcodeMsgPackToJson("\x81\x01\x02", 3, output) ==
+            DeserializationError::InvalidInput);
+  }
+
+  SECTION("nesting limit") {
+    std::string output;
+
+    REQUIRE(transcodeMsgPackToJson("\x91\x91\x01", output,
+                                   DeserializationOption::NestingLimit(1)) ==
+            DeserializationError::TooDeep);
+    REQUIRE(transcodeMsgPackToJson("\x91\x91\x01", output,
+                                   DeserializationOption::NestingLimit(2)) ==
+            DeserializationError::Ok);
+  }
+}
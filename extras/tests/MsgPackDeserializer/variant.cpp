@@ -0,0 +1,41 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+TEST_CASE("deserializeMsgPack(JsonVariant)") {
+  DynamicJsonDocument doc(4096);
+  doc["version"] = 1;
+
+  SECTION("parses into a new member") {
+    DeserializationError err = deserializeMsgPack(doc["list"], "\x92\x01\x02");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"version\":1,\"list\":[1,2]}");
+  }
+
+  SECTION("merges objects") {
+    doc["config"]["a"] = 1;
+    doc["config"]["b"]["x"] = 2;
+    doc["config"]["c"] = 3;
+
+    DeserializationError err =
+        deserializeMsgPack(doc["config"],
+                           "\x84\xA1\x61\x0A\xA1\x62\x81\xA1y\x14"
+                           "\xA1\x63\xC0\xA1\x64\x04");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["config"].as<std::string>() ==
+            "{\"a\":10,\"b\":{\"x\":2,\"y\":20},\"c\":null,\"d\":4}");
+  }
+
+  SECTION("input size") {
+    deserializeMsgPack(doc["x"], "\x01\x02", 1);
+
+    REQUIRE(doc["x"] == 1);
+  }
+}
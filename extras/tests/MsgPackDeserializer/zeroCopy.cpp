@@ -0,0 +1,95 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+TEST_CASE("deserializeMsgPack(DeserializationOption::ZeroCopy)") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("links the values and copies the keys") {
+    const char input[] = "\x82\xA1" "a" "\xA5hello\xA1" "b" "\x91\xA5world";
+
+    DeserializationError err = deserializeMsgPack(
+        doc, input, sizeof(input) - 1, DeserializationOption::ZeroCopy());
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.memoryUsage() ==
+            JSON_OBJECT_SIZE(2) + JSON_ARRAY_SIZE(1) + 2 * 2);
+    REQUIRE(doc["a"].as<JsonString>().c_str() == input + 4);
+    REQUIRE(doc["a"].as<JsonString>().size() == 5);
+    REQUIRE(doc["a"] == "hello");
+    REQUIRE(doc["b"][0] == "world");
+  }
+
+  SECTION("serializes the strings") {
+    const char input[] = "\x92\xA2hi\xA5world";
+
+    deserializeMsgPack(doc, input, sizeof(input) - 1,
+                       DeserializationOption::ZeroCopy());
+
+    REQUIRE(doc.as<std::string>() == "[\"hi\",\"world\"]");
+
+    std::string output;
+    serializeMsgPack(doc, output);
+    REQUIRE(output == input);
+  }
+
+  SECTION("the strings are not null-terminated") {
+    const char input[] = "\x92\xA2hi\x01";
+
+    deserializeMsgPack(doc, input, sizeof(input) - 1,
+                       DeserializationOption::ZeroCopy());
+
+    REQUIRE(doc[0].is<const char*>() == false);
+    REQUIRE(doc[0].as<const char*>() == nullptr);
+    REQUIRE(doc[0].is<JsonString>() == true);
+    REQUIRE(doc[0].as<std::string>() == "hi");
+  }
+
+  SECTION("empty string") {
+    deserializeMsgPack(doc, "\xA0", 1, DeserializationOption::ZeroCopy());
+
+    REQUIRE(doc.as<const char*>() == std::string(""));
+  }
+
+  SECTION("std::string") {
+    std::string input("\x91\xA5hello", 7);
+
+    deserializeMsgPack(doc, input, DeserializationOption::ZeroCopy());
+
+    REQUIRE(doc[0].as<JsonString>().c_str() == input.data() + 2);
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(1));
+  }
+
+  SECTION("mutable input") {
+    char input[] = "\x91\xA5hello";
+
+    deserializeMsgPack(doc, input, DeserializationOption::ZeroCopy());
+
+    // already moved in place, and null-terminated
+    REQUIRE(doc[0].as<const char*>() == input);
+  }
+
+  SECTION("incomplete input") {
+    DeserializationError err = deserializeMsgPack(
+        doc, "\x91\xA5hel", 5, DeserializationOption::ZeroCopy());
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("with stats") {
+    const char input[] = "\x81\xA1" "a" "\xA5hello";
+    DeserializationStats stats;
+
+    deserializeMsgPack(doc, input, sizeof(input) - 1,
+                       DeserializationOption::ZeroCopy(), &stats);
+
+    REQUIRE(doc["a"] == "hello");
+    REQUIRE(stats.bytesRead == 9);
+    REQUIRE(stats.stringBytes == 2);
+  }
+}
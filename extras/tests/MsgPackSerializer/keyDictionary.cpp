@@ -0,0 +1,108 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+static const char* const dictionaryKeys[] = {"temperature", "humidity",
+                                             "sensor"};
+
+TEST_CASE("serializeMsgPack(..., KeyDictionary)") {
+  DynamicJsonDocument doc(4096);
+  KeyDictionary dictionary(dictionaryKeys);
+  std::string output;
+
+  SECTION("replaces the keys with their index") {
+    doc["sensor"] = "A";
+    doc["temperature"] = 21;
+
+    size_t n = serializeMsgPack(doc, output, dictionary);
+
+    REQUIRE(output == std::string("\x82\x02\xA1" "A\x00\x15", 6));
+    REQUIRE(n == output.size());
+  }
+
+  SECTION("keeps the keys that are not in the dictionary") {
+    doc["other"] = 1;
+    doc["humidity"] = 2;
+
+    serializeMsgPack(doc, output, dictionary);
+
+    REQUIRE(output == "\x82\xA5other\x01\x01\x02");
+  }
+
+  SECTION("nested objects") {
+    doc["sensor"]["humidity"] = 3;
+
+    serializeMsgPack(doc, output, dictionary);
+
+    REQUIRE(output == "\x81\x02\x81\x01\x03");
+  }
+
+  SECTION("strings values are not replaced") {
+    doc["sensor"] = "humidity";
+
+    serializeMsgPack(doc, output, dictionary);
+
+    REQUIRE(output == "\x81\x02\xA8humidity");
+  }
+
+  SECTION("index 128 and above") {
+    const char* many[200];
+    std::string names[200];
+    for (int i = 0; i < 200; i++) {
+      names[i] = "k" + std::to_string(i);
+      many[i] = names[i].c_str();
+    }
+    doc["k150"] = 1;
+
+    serializeMsgPack(doc, output, KeyDictionary(many, 200));
+
+    REQUIRE(output == "\x81\xCC\x96\x01");
+  }
+
+  SECTION("buffer and measure") {
+    doc["humidity"] = 2;
+    char buffer[8];
+
+    REQUIRE(measureMsgPack(doc, dictionary) == 3);
+    REQUIRE(serializeMsgPack(doc, buffer, sizeof(buffer), dictionary) == 3);
+    REQUIRE(std::string(buffer, 3) == "\x81\x01\x02");
+  }
+}
+
+TEST_CASE("learnKeys()") {
+  DynamicJsonDocument doc(4096);
+  deserializeJson(doc, "[{\"a\":1,\"b\":{\"c\":2}},{\"b\":3,\"d\":[{\"a\":4}]}]");
+  const char* learned[8];
+
+  SECTION("collects the distinct keys") {
+    size_t n = learnKeys(doc, learned, 8);
+
+    REQUIRE(n == 4);
+    REQUIRE(std::string(learned[0]) == "a");
+    REQUIRE(std::string(learned[1]) == "b");
+    REQUIRE(std::string(learned[2]) == "c");
+    REQUIRE(std::string(learned[3]) == "d");
+  }
+
+  SECTION("stops at the capacity") {
+    REQUIRE(learnKeys(doc, learned, 2) == 2);
+  }
+
+  SECTION("round trip") {
+    size_t n = learnKeys(doc, learned, 8);
+    KeyDictionary dictionary(learned, n);
+    std::string output;
+    serializeMsgPack(doc, output, dictionary);
+
+    DynamicJsonDocument doc2(4096);
+    REQUIRE(deserializeMsgPack(doc2, output, dictionary) ==
+            DeserializationError::Ok);
+    REQUIRE(doc2 == doc);
+    REQUIRE(output.size() < measureMsgPack(doc));
+  }
+}
@@ -146,6 +146,35 @@ TEST_CASE("serialize MsgPack value") {
     checkVariant(serialized("\xDB\x00\x01\x00\x00", 5), "\xDB\x00\x01\x00\x00");
   }
 
+  SECTION("bin 8") {
+    checkVariant(JsonBinary("\x01\x02", 2), "\xC4\x02\x01\x02");
+  }
+
+  SECTION("bin 16") {
+    std::string data(256, '?');
+    checkVariant(JsonBinary(data.data(), data.size()),
+                 std::string("\xC5\x01\x00", 3) + data);
+  }
+
+  SECTION("fixext") {
+    checkVariant(JsonBinary(-1, "\x01", 1), "\xD4\xFF\x01");
+    checkVariant(JsonBinary(2, "\x01\x02", 2), "\xD5\x02\x01\x02");
+    checkVariant(JsonBinary(3, "ABCD", 4), "\xD6\x03" "ABCD");
+    checkVariant(JsonBinary(4, "ABCDEFGH", 8), "\xD7\x04" "ABCDEFGH");
+    checkVariant(JsonBinary(5, "ABCDEFGHIJKLMNOP", 16),
+                 "\xD8\x05" "ABCDEFGHIJKLMNOP");
+  }
+
+  SECTION("ext 8") {
+    checkVariant(JsonBinary(6, "ABC", 3), "\xC7\x03\x06" "ABC");
+  }
+
+  SECTION("ext 16") {
+    std::string data(256, '?');
+    checkVariant(JsonBinary(7, data.data(), data.size()),
+                 std::string("\xC8\x01\x00\x07", 4) + data);
+  }
+
   SECTION("serialize round double as integer") {  // Issue #1718
     checkVariant(-32768.0, "\xD1\x80\x00");
     checkVariant(-129.0, "\xD1\xFF\x7F");
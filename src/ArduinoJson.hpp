@@ -31,6 +31,7 @@
 #include "ArduinoJson/Variant/JsonVariantConst.hpp"
 
 #include "ArduinoJson/Document/DynamicJsonDocument.hpp"
+#include "ArduinoJson/Document/JsonDocumentPool.hpp"
 #include "ArduinoJson/Document/StaticJsonDocument.hpp"
 
 #include "ArduinoJson/Array/ElementProxy.hpp"
@@ -43,10 +44,16 @@
 #include "ArduinoJson/Variant/VariantCompare.hpp"
 #include "ArduinoJson/Variant/VariantImpl.hpp"
 
+#include "ArduinoJson/Cbor/CborDeserializer.hpp"
+#include "ArduinoJson/Cbor/CborSerializer.hpp"
+#include "ArduinoJson/Document/Snapshot.hpp"
 #include "ArduinoJson/Json/JsonDeserializer.hpp"
+#include "ArduinoJson/Json/JsonExtractionPlan.hpp"
+#include "ArduinoJson/Json/JsonPointer.hpp"
 #include "ArduinoJson/Json/JsonSerializer.hpp"
 #include "ArduinoJson/Json/PrettyJsonSerializer.hpp"
 #include "ArduinoJson/MsgPack/MsgPackDeserializer.hpp"
 #include "ArduinoJson/MsgPack/MsgPackSerializer.hpp"
+#include "ArduinoJson/MsgPack/transcode.hpp"
 
 #include "ArduinoJson/compatibility.hpp"
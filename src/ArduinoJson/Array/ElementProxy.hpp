@@ -45,12 +45,16 @@ class ElementProxy : public VariantRefBase<ElementProxy<TUpstream>>,
   }
 
   FORCE_INLINE VariantData* getData() const {
-    return variantGetElement(VariantAttorney::getData(upstream_), index_);
+    MemoryPool* pool = VariantAttorney::getPool(upstream_);
+    return variantGetElement(
+        variantResolve(VariantAttorney::getData(upstream_), pool), index_);
   }
 
   FORCE_INLINE VariantData* getOrCreateData() const {
-    return variantGetOrAddElement(VariantAttorney::getOrCreateData(upstream_),
-                                  index_, VariantAttorney::getPool(upstream_));
+    MemoryPool* pool = VariantAttorney::getPool(upstream_);
+    return variantGetOrAddElement(
+        variantResolve(VariantAttorney::getOrCreateData(upstream_), pool),
+        index_, pool);
   }
 
   TUpstream upstream_;
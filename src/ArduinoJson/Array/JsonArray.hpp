@@ -90,29 +90,30 @@ class JsonArray : public detail::VariantOperators<JsonArray> {
   }
 
   // Removes the element at the specified iterator.
-  // ⚠️ Doesn't release the memory associated with the removed element.
+  // The pool reuses the memory of the removed element.
   // https://arduinojson.org/v6/api/jsonarray/remove/
   FORCE_INLINE void remove(iterator it) const {
     if (!data_)
       return;
-    data_->removeSlot(it.slot_);
+    data_->removeSlot(it.slot_, pool_);
   }
 
   // Removes the element at the specified index.
-  // ⚠️ Doesn't release the memory associated with the removed element.
+  // The pool reuses the memory of the removed element.
   // https://arduinojson.org/v6/api/jsonarray/remove/
   FORCE_INLINE void remove(size_t index) const {
     if (!data_)
       return;
-    data_->removeElement(index);
+    data_->removeElement(index, pool_);
   }
 
   // Removes all the elements of the array.
-  // ⚠️ Doesn't release the memory associated with the removed elements.
+  // The pool reuses the memory of the removed elements.
   // https://arduinojson.org/v6/api/jsonarray/clear/
   void clear() const {
     if (!data_)
       return;
+    data_->release(pool_);
     data_->clear();
   }
 
@@ -190,8 +191,8 @@ struct Converter<JsonArray> : private detail::VariantAttorney {
   }
 
   static JsonArray fromJson(JsonVariant src) {
-    auto data = getData(src);
     auto pool = getPool(src);
+    auto data = variantResolve(getData(src), pool);
     return JsonArray(pool, data != 0 ? data->asArray() : 0);
   }
 
@@ -203,7 +204,7 @@ struct Converter<JsonArray> : private detail::VariantAttorney {
   }
 
   static bool checkJson(JsonVariant src) {
-    auto data = getData(src);
+    auto data = variantResolve(getData(src), getPool(src));
     return data && data->isArray();
   }
 };
@@ -0,0 +1,794 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Cbor/CborSerializer.hpp>
+#include <ArduinoJson/Deserialization/deserialize.hpp>
+#include <ArduinoJson/Memory/MemoryPool.hpp>
+#include <ArduinoJson/MsgPack/endianess.hpp>
+#include <ArduinoJson/MsgPack/ieee754.hpp>
+#include <ArduinoJson/Polyfills/alias_cast.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+template <typename TReader, typename TStringStorage>
+class CborDeserializer {
+ public:
+  CborDeserializer(MemoryPool* pool, TReader reader,
+                   TStringStorage stringStorage)
+      : pool_(pool),
+        reader_(reader),
+        stringStorage_(stringStorage),
+        foundSomething_(false) {}
+
+  template <typename TFilter>
+  DeserializationError parse(VariantData& variant, TFilter filter,
+                             DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+    err = parseVariant(&variant, filter, nestingLimit);
+    return foundSomething_ ? err : DeserializationError::EmptyInput;
+  }
+
+  // Keys are only replaced by indexes in MessagePack, but the string keys
+  // found in the dictionary are linked, see KeyDictionary
+  void setKeyDictionary(KeyDictionary keys) {
+    keys_ = keys;
+  }
+
+ private:
+  // The additional information that marks an indefinite length
+  static const uint8_t indefinite = 31;
+
+  // The initial byte that ends an item of indefinite length
+  static const uint8_t breakCode = 0xFF;
+
+  template <typename TFilter>
+  DeserializationError::Code parseVariant(
+      VariantData* variant, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    uint8_t code = 0;
+    err = readByte(code);
+    if (err)
+      return err;
+
+    foundSomething_ = true;
+
+    return parseVariant(code, variant, filter, nestingLimit);
+  }
+
+  template <typename TFilter>
+  DeserializationError::Code parseVariant(
+      uint8_t code, VariantData* variant, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    bool allowValue = filter.allowValue();
+
+    if (allowValue) {
+      // callers pass a null pointer only when value must be ignored
+      ARDUINOJSON_ASSERT(variant != 0);
+    }
+
+    uint8_t info = code & 0x1f;
+
+    switch (code & 0xe0) {
+      case CBOR_UNSIGNED_INTEGER:
+        if (allowValue)
+          return readInteger(variant, info, false);
+        else
+          return skipArgument(info);
+
+      case CBOR_NEGATIVE_INTEGER:
+        if (allowValue)
+          return readInteger(variant, info, true);
+        else
+          return skipArgument(info);
+
+      case CBOR_BYTE_STRING:
+      case CBOR_TEXT_STRING:
+        if (allowValue)
+          return readString(variant, CborMajorType(code & 0xe0), info);
+        else
+          return skipString(CborMajorType(code & 0xe0), info);
+
+      case CBOR_ARRAY:
+        return readArray(variant, info, filter, nestingLimit);
+
+      case CBOR_MAP:
+        return readObject(variant, info, filter, nestingLimit);
+
+      case CBOR_TAG:
+        return readTagged(info, variant, filter, nestingLimit);
+    }
+
+    switch (info) {
+      case 20:
+        if (allowValue)
+          variant->setBoolean(false);
+        return DeserializationError::Ok;
+
+      case 21:
+        if (allowValue)
+          variant->setBoolean(true);
+        return DeserializationError::Ok;
+
+      case 25:
+        if (allowValue)
+          return readHalf(variant);
+        else
+          return skipBytes(2);
+
+      case 26:
+        if (allowValue)
+          return readFloat<float>(variant);
+        else
+          return skipBytes(4);
+
+      case 27:
+        if (allowValue)
+          return readDouble<JsonFloat>(variant);
+        else
+          return skipBytes(8);
+
+      case 24: {
+        // simple values 0-31 must use the one-byte form (RFC 8949 3.3)
+        uint8_t value;
+        DeserializationError::Code err = readByte(value);
+        if (err)
+          return err;
+        if (value < 32)
+          return DeserializationError::InvalidInput;
+        break;
+      }
+
+      case 28:
+      case 29:
+      case 30:
+      case indefinite:  // a break outside of an indefinite length item
+        return DeserializationError::InvalidInput;
+    }
+
+    // null (22), undefined (23), and unassigned simple values (0-19, and 24
+    // followed by 32-255) become null.
+    // usually null already, except when merging
+    if (allowValue)
+      variant->setNull();
+    return info == 24 ? DeserializationError::Ok : skipArgument(info);
+  }
+
+  DeserializationError::Code readByte(uint8_t& value) {
+    int c = reader_.read();
+    if (c < 0)
+      return DeserializationError::IncompleteInput;
+    value = static_cast<uint8_t>(c);
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code readBytes(uint8_t* p, size_t n) {
+    if (reader_.readBytes(reinterpret_cast<char*>(p), n) == n)
+      return DeserializationError::Ok;
+    return DeserializationError::IncompleteInput;
+  }
+
+  template <typename T>
+  DeserializationError::Code readBytes(T& value) {
+    return readBytes(reinterpret_cast<uint8_t*>(&value), sizeof(value));
+  }
+
+  DeserializationError::Code skipBytes(size_t n) {
+    if (skipInput(reader_, n) < n)
+      return DeserializationError::IncompleteInput;
+    return DeserializationError::Ok;
+  }
+
+  template <typename T>
+  DeserializationError::Code readInteger(T& value) {
+    DeserializationError::Code err;
+
+    err = readBytes(value);
+    if (err)
+      return err;
+
+    fixEndianess(value);
+
+    return DeserializationError::Ok;
+  }
+
+  // Reads a length or a tag: the additional information itself below 24, or
+  // the 1, 2, 4, or 8 bytes that follow.
+  // Returns NoMemory if the value doesn't fit in 32 bits.
+  DeserializationError::Code readLength(uint8_t info, size_t& value) {
+    DeserializationError::Code err;
+
+    if (info < 24) {
+      value = info;
+      return DeserializationError::Ok;
+    }
+
+    switch (info) {
+      case 24:
+        return readLength<uint8_t>(value);
+
+      case 25:
+        return readLength<uint16_t>(value);
+
+      case 26:
+        return readLength<uint32_t>(value);
+
+      case 27: {
+        uint32_t high;
+        err = readInteger(high);
+        if (err)
+          return err;
+        if (high)
+          return DeserializationError::NoMemory;
+        return readLength<uint32_t>(value);
+      }
+
+      default:
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+  template <typename T>
+  DeserializationError::Code readLength(size_t& value) {
+    DeserializationError::Code err;
+    T length;
+
+    err = readInteger(length);
+    if (err)
+      return err;
+
+    value = length;
+    return DeserializationError::Ok;
+  }
+
+  // Skips the bytes that follow the initial byte, see readLength()
+  DeserializationError::Code skipArgument(uint8_t info) {
+    if (info < 24)
+      return DeserializationError::Ok;
+    if (info > 27)
+      return DeserializationError::InvalidInput;
+    return skipBytes(size_t(1) << (info - 24));
+  }
+
+  DeserializationError::Code readInteger(VariantData* variant, uint8_t info,
+                                         bool negative) {
+    StatsTimer<TStringStorage> timer(stringStorage_,
+                                     &DeserializationStats::numberTime);
+
+    if (info < 24) {
+      setInteger(variant, info, negative);
+      return DeserializationError::Ok;
+    }
+
+    switch (info) {
+      case 24:
+        return readInteger<uint8_t>(variant, negative);
+
+      case 25:
+        return readInteger<uint16_t>(variant, negative);
+
+      case 26:
+        return readInteger<uint32_t>(variant, negative);
+
+      case 27:
+#if ARDUINOJSON_USE_LONG_LONG
+        return readInteger<uint64_t>(variant, negative);
+#else
+        return skipBytes(8);  // not supported
+#endif
+
+      default:
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+  template <typename T>
+  DeserializationError::Code readInteger(VariantData* variant, bool negative) {
+    DeserializationError::Code err;
+    T value;
+
+    err = readInteger(value);
+    if (err)
+      return err;
+
+    setInteger(variant, value, negative);
+    return DeserializationError::Ok;
+  }
+
+  // A negative integer is encoded as -1 minus the value
+  template <typename T>
+  static void setInteger(VariantData* variant, T value, bool negative) {
+    if (!negative)
+      variant->setInteger(value);
+    else if (canConvertNumber<JsonInteger>(value))
+      variant->setInteger(-1 - JsonInteger(value));
+    else
+      variant->setFloat(-1 - JsonFloat(value));
+  }
+
+  DeserializationError::Code readHalf(VariantData* variant) {
+    DeserializationError::Code err;
+    StatsTimer<TStringStorage> timer(stringStorage_,
+                                     &DeserializationStats::numberTime);
+    uint16_t value;
+
+    err = readInteger(value);
+    if (err)
+      return err;
+
+    variant->setFloat(alias_cast<float>(halfToFloat(value)));
+
+    return DeserializationError::Ok;
+  }
+
+  template <typename T>
+  DeserializationError::Code readFloat(VariantData* variant) {
+    DeserializationError::Code err;
+    StatsTimer<TStringStorage> timer(stringStorage_,
+                                     &DeserializationStats::numberTime);
+    T value;
+
+    err = readBytes(value);
+    if (err)
+      return err;
+
+    fixEndianess(value);
+    variant->setFloat(value);
+
+    return DeserializationError::Ok;
+  }
+
+  template <typename T>
+  typename enable_if<sizeof(T) == 8, DeserializationError::Code>::type
+  readDouble(VariantData* variant) {
+    return readFloat<T>(variant);
+  }
+
+  template <typename T>
+  typename enable_if<sizeof(T) == 4, DeserializationError::Code>::type
+  readDouble(VariantData* variant) {
+    DeserializationError::Code err;
+    StatsTimer<TStringStorage> timer(stringStorage_,
+                                     &DeserializationStats::numberTime);
+    uint8_t i[8];  // input is 8 bytes
+    T value;       // output is 4 bytes
+    uint8_t* o = reinterpret_cast<uint8_t*>(&value);
+
+    err = readBytes(i, 8);
+    if (err)
+      return err;
+
+    doubleToFloat(i, o);
+    fixEndianess(value);
+    variant->setFloat(value);
+
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code readString(VariantData* variant,
+                                        CborMajorType type, uint8_t info) {
+    DeserializationError::Code err;
+
+    stringStorage_.startString();
+    if (info == indefinite) {
+      err = appendChunks(type);
+    } else {
+      size_t n;
+      err = readLength(info, n);
+      if (err)
+        return err;
+
+      // see DeserializationOption::ZeroCopy
+      const char* s = n ? readInPlace(reader_, n) : 0;
+      if (s) {
+        if (type == CBOR_TEXT_STRING)
+          variant->setUnterminatedString(s, n);
+        else
+          variant->setBinary(JsonString(s, n, JsonString::Linked));
+        return DeserializationError::Ok;
+      }
+
+      err = appendBytes(n);
+    }
+    if (err)
+      return err;
+
+    if (type == CBOR_TEXT_STRING)
+      variant->setString(stringStorage_);
+    else
+      variant->setBinary(stringStorage_.save());
+    return DeserializationError::Ok;
+  }
+
+  // Stores the tag as the extension type, followed by the bytes
+  DeserializationError::Code readExt(VariantData* variant, uint8_t tag,
+                                     uint8_t info) {
+    DeserializationError::Code err;
+
+    stringStorage_.startString();
+    stringStorage_.append(char(tag));
+    err = appendString(CBOR_BYTE_STRING, info);
+    if (err)
+      return err;
+
+    variant->setExt(stringStorage_.save());
+    return DeserializationError::Ok;
+  }
+
+  // Appends the content of a string to the string storage
+  DeserializationError::Code appendString(CborMajorType type, uint8_t info) {
+    DeserializationError::Code err;
+
+    if (info == indefinite)
+      return appendChunks(type);
+
+    size_t n;
+    err = readLength(info, n);
+    if (err)
+      return err;
+
+    return appendBytes(n);
+  }
+
+  // A string of indefinite length is a sequence of chunks of definite length
+  // followed by a break.
+  DeserializationError::Code appendChunks(CborMajorType type) {
+    DeserializationError::Code err;
+
+    for (;;) {
+      uint8_t code;
+      err = readByte(code);
+      if (err)
+        return err;
+
+      if (code == breakCode)
+        return DeserializationError::Ok;
+
+      if ((code & 0xe0) != type || (code & 0x1f) == indefinite)
+        return DeserializationError::InvalidInput;
+
+      size_t n;
+      err = readLength(code & 0x1f, n);
+      if (err)
+        return err;
+
+      err = appendBytes(n);
+      if (err)
+        return err;
+    }
+  }
+
+  DeserializationError::Code appendBytes(size_t n) {
+    StatsTimer<TStringStorage> timer(stringStorage_,
+                                     &DeserializationStats::stringTime);
+
+    if (!stringStorage_.appendFrom(reader_, n))
+      return DeserializationError::IncompleteInput;
+
+    // the storage didn't read the bytes, so we can't go on with the next chunk
+    if (!stringStorage_.isValid())
+      return DeserializationError::NoMemory;
+
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code skipString(CborMajorType type, uint8_t info) {
+    DeserializationError::Code err;
+    bool chunked = info == indefinite;
+
+    for (;;) {
+      if (chunked) {
+        uint8_t code;
+        err = readByte(code);
+        if (err)
+          return err;
+        if (code == breakCode)
+          return DeserializationError::Ok;
+        info = code & 0x1f;
+        if ((code & 0xe0) != type || info == indefinite)
+          return DeserializationError::InvalidInput;
+      }
+
+      size_t n;
+      err = readLength(info, n);
+      if (err)
+        return err;
+
+      err = skipBytes(n);
+      if (err || !chunked)
+        return err;
+    }
+  }
+
+  // Ignores the tags, except the ones below 128 on a byte string, which
+  // become the type of an ext (see CborSerializer::visitBinary)
+  template <typename TFilter>
+  DeserializationError::Code readTagged(
+      uint8_t info, VariantData* variant, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+    uint8_t code = 0;
+    size_t tag;
+
+    // when there are several tags, only the innermost one matters
+    do {
+      tag = 0x80;  // not an extension type
+      if (info == 27)
+        err = skipBytes(8);
+      else
+        err = readLength(info, tag);
+      if (err)
+        return err;
+
+      err = readByte(code);
+      if (err)
+        return err;
+      info = code & 0x1f;
+    } while ((code & 0xe0) == CBOR_TAG);
+
+    if (tag < 0x80 && (code & 0xe0) == CBOR_BYTE_STRING && filter.allowValue())
+      return readExt(variant, uint8_t(tag), info);
+
+    return parseVariant(code, variant, filter, nestingLimit);
+  }
+
+  template <typename TFilter>
+  DeserializationError::Code readArray(
+      VariantData* variant, uint8_t info, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err = DeserializationError::Ok;
+
+    bool chunked = info == indefinite;
+    size_t n = 0;
+    if (!chunked) {
+      err = readLength(info, n);
+      if (err)
+        return err;
+    }
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    bool allowArray = filter.allowArray();
+
+    CollectionData* array;
+    if (allowArray) {
+      ARDUINOJSON_ASSERT(variant != 0);
+      array = &variant->toArray();
+    } else {
+      array = 0;
+    }
+
+    TFilter memberFilter = filter[0U];
+
+    // When the length is known, reserve all the slots at once, so we fail
+    // before reading the elements
+    VariantSlot* slot = 0;
+    if (memberFilter.allow() && n) {
+      ARDUINOJSON_ASSERT(array != 0);
+      slot = array->addSlots(n, pool_);
+      if (!slot)
+        return DeserializationError::NoMemory;
+    }
+
+    for (;;) {
+      uint8_t code = 0;
+      if (!chunked && !n--)
+        break;
+      err = readByte(code);
+      if (err)
+        break;
+      if (chunked && code == breakCode)
+        break;
+
+      VariantData* value;
+      if (slot) {
+        value = slot->data();
+      } else if (chunked && memberFilter.allow()) {
+        ARDUINOJSON_ASSERT(array != 0);
+        VariantSlot* added = array->addSlot(pool_);
+        if (!added)
+          return DeserializationError::NoMemory;
+        value = added->data();
+      } else {
+        value = 0;
+      }
+
+      SkipCounter<TStringStorage> counter(stringStorage_,
+                                          allowArray && !value, 1);
+      err = parseVariant(code, value, memberFilter, nestingLimit.decrement());
+      if (err)
+        break;
+
+      if (slot)
+        slot = slot->next();
+    }
+
+    // remove the reserved slots that weren't reached
+    if (err && slot)
+      array->removeSlotsAfter(slot, pool_);
+
+    return err;
+  }
+
+  template <typename TFilter>
+  DeserializationError::Code readObject(
+      VariantData* variant, uint8_t info, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err = DeserializationError::Ok;
+
+    bool chunked = info == indefinite;
+    size_t n = 0;
+    if (!chunked) {
+      err = readLength(info, n);
+      if (err)
+        return err;
+    }
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    CollectionData* object;
+    if (filter.allowObject()) {
+      ARDUINOJSON_ASSERT(variant != 0);
+      // merge with the existing members, if any
+      object = variant->isObject() ? variant->asObject() : &variant->toObject();
+    } else {
+      object = 0;
+    }
+
+    // look for existing members only when merging
+    bool merge = object && object->head();
+
+    // When the length is known and all members are allowed, reserve all the
+    // slots at once, so we fail before reading the members
+    VariantSlot* reserved = 0;
+    if (object && !merge && n && allowsAllMembers(filter)) {
+      reserved = object->addSlots(n, pool_);
+      if (!reserved)
+        return DeserializationError::NoMemory;
+    }
+    VariantSlot* lastUsed = 0;
+
+    for (;;) {
+      uint8_t code = 0;
+      if (!chunked && !n--)
+        break;
+      err = readByte(code);
+      if (err)
+        break;
+      if (chunked && code == breakCode)
+        break;
+
+      err = readKey(code);
+      if (err)
+        break;
+
+      JsonString key = stringStorage_.str();
+      TFilter memberFilter = filter[key.c_str()];
+      VariantData* member;
+
+      if (reserved) {
+        if (!reserved->setKey(saveKey(), pool_)) {
+          err = DeserializationError::NoMemory;
+          break;
+        }
+        lastUsed = reserved;
+        reserved = reserved->next();
+        member = lastUsed->data();
+      } else if (memberFilter.allow()) {
+        ARDUINOJSON_ASSERT(object != 0);
+
+        member = merge ? object->getMember(adaptString(key.c_str())) : 0;
+        if (!member) {
+          // Save key in memory pool, unless it's in the dictionary.
+          // This MUST be done before adding the slot.
+          key = saveKey();
+
+          VariantSlot* slot = object->addSlot(pool_);
+          if (!slot)
+            return DeserializationError::NoMemory;
+
+          if (!slot->setKey(key, pool_)) {
+            object->removeSlot(slot, pool_);
+            return DeserializationError::NoMemory;
+          }
+
+          member = slot->data();
+        }
+      } else {
+        member = 0;
+      }
+
+      SkipCounter<TStringStorage> counter(stringStorage_, object && !member, 0);
+      err = parseVariant(member, memberFilter, nestingLimit.decrement());
+      if (err)
+        break;
+    }
+
+    // remove the reserved slots that don't have a key
+    if (err && reserved)
+      object->removeSlotsAfter(lastUsed, pool_);
+
+    return err;
+  }
+
+  // Reads a text string key into the string storage
+  DeserializationError::Code readKey(uint8_t code) {
+    DeserializationError::Code err;
+
+    if ((code & 0xe0) != CBOR_TEXT_STRING)
+      return DeserializationError::InvalidInput;
+
+    stringStorage_.startString();
+    err = appendString(CBOR_TEXT_STRING, code & 0x1f);
+    if (err)
+      return err;
+
+    return DeserializationError::Ok;
+  }
+
+  // Links the key to the dictionary if it's there, saves it otherwise
+  JsonString saveKey() {
+    JsonString key = stringStorage_.str();
+    const char* linked = keys_.find(key.c_str(), key.size());
+    if (linked)
+      return JsonString(linked, JsonString::Linked);
+    return stringStorage_.save();
+  }
+
+  MemoryPool* pool_;
+  TReader reader_;
+  TStringStorage stringStorage_;
+  bool foundSomething_;
+  KeyDictionary keys_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Parses a CBOR input (RFC 8949) and puts the result in a JsonDocument.
+template <typename... Args>
+DeserializationError deserializeCbor(JsonDocument& doc, Args&&... args) {
+  using namespace detail;
+  return deserialize<CborDeserializer>(doc, detail::forward<Args>(args)...);
+}
+
+// Parses a CBOR input (RFC 8949) and puts the result in a JsonDocument.
+template <typename TChar, typename... Args>
+DeserializationError deserializeCbor(JsonDocument& doc, TChar* input,
+                                     Args&&... args) {
+  using namespace detail;
+  return deserialize<CborDeserializer>(doc, input,
+                                       detail::forward<Args>(args)...);
+}
+
+// Parses a CBOR input into a variant of an existing document.
+// The document isn't cleared; objects are merged with the existing members.
+template <typename TVariant, typename... Args>
+typename detail::enable_if<detail::IsVariant<TVariant>::value,
+                           DeserializationError>::type
+deserializeCbor(const TVariant& dst, Args&&... args) {
+  using namespace detail;
+  return deserialize<CborDeserializer>(dst, detail::forward<Args>(args)...);
+}
+
+// Parses a CBOR input into a variant of an existing document.
+// The document isn't cleared; objects are merged with the existing members.
+template <typename TVariant, typename TChar, typename... Args>
+typename detail::enable_if<detail::IsVariant<TVariant>::value,
+                           DeserializationError>::type
+deserializeCbor(const TVariant& dst, TChar* input, Args&&... args) {
+  using namespace detail;
+  return deserialize<CborDeserializer>(dst, input,
+                                       detail::forward<Args>(args)...);
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
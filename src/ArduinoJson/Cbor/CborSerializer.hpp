@@ -0,0 +1,214 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/MsgPack/endianess.hpp>
+#include <ArduinoJson/MsgPack/ieee754.hpp>
+#include <ArduinoJson/Polyfills/alias_cast.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Serialization/CountingDecorator.hpp>
+#include <ArduinoJson/Serialization/measure.hpp>
+#include <ArduinoJson/Serialization/serialize.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The major types of CBOR, in the 3 high bits of the initial byte
+enum CborMajorType {
+  CBOR_UNSIGNED_INTEGER = 0x00,
+  CBOR_NEGATIVE_INTEGER = 0x20,
+  CBOR_BYTE_STRING = 0x40,
+  CBOR_TEXT_STRING = 0x60,
+  CBOR_ARRAY = 0x80,
+  CBOR_MAP = 0xA0,
+  CBOR_TAG = 0xC0,
+  CBOR_SIMPLE_OR_FLOAT = 0xE0,
+};
+
+// Produces the preferred serialization of RFC 8949: definite lengths, and the
+// shortest form of each argument and float.
+template <typename TWriter>
+class CborSerializer : public Visitor<size_t> {
+ public:
+  static const bool producesText = false;
+
+  CborSerializer(TWriter writer) : writer_(writer) {}
+
+  template <typename T>
+  typename enable_if<sizeof(T) == 4, size_t>::type visitFloat(T value32) {
+    if (canConvertNumber<JsonInteger>(value32)) {
+      JsonInteger truncatedValue = JsonInteger(value32);
+      if (value32 == T(truncatedValue))
+        return visitSignedInteger(truncatedValue);
+    }
+    uint16_t value16;
+    if (floatToHalf(alias_cast<uint32_t>(value32), value16)) {
+      writeByte(0xF9);
+      writeInteger(value16);
+    } else {
+      writeByte(0xFA);
+      writeInteger(value32);
+    }
+    return bytesWritten();
+  }
+
+  template <typename T>
+  ARDUINOJSON_NO_SANITIZE("float-cast-overflow")
+  typename enable_if<sizeof(T) == 8, size_t>::type visitFloat(T value64) {
+    float value32 = float(value64);
+    if (value32 == value64 || isnan(value64))  // NaN != NaN
+      return visitFloat(value32);
+    writeByte(0xFB);
+    writeInteger(value64);
+    return bytesWritten();
+  }
+
+  size_t visitArray(const CollectionData& array) {
+    writeHeader(CBOR_ARRAY, array.size());
+    for (const VariantSlot* slot = array.head(); slot; slot = slot->next()) {
+      slot->data()->accept(*this);
+    }
+    return bytesWritten();
+  }
+
+  size_t visitObject(const CollectionData& object) {
+    writeHeader(CBOR_MAP, object.size());
+    for (const VariantSlot* slot = object.head(); slot; slot = slot->next()) {
+      visitString(slot->key(), slot->keySize());
+      slot->data()->accept(*this);
+    }
+    return bytesWritten();
+  }
+
+  size_t visitString(const char* value) {
+    return visitString(value, strlen(value));
+  }
+
+  size_t visitString(const char* value, size_t n) {
+    ARDUINOJSON_ASSERT(value != NULL);
+    writeHeader(CBOR_TEXT_STRING, n);
+    writeBytes(reinterpret_cast<const uint8_t*>(value), n);
+    return bytesWritten();
+  }
+
+  // An ext with a positive type is written as a byte string with a tag, so
+  // that deserializeCbor() restores it; the other types are lost.
+  size_t visitBinary(JsonBinary value) {
+    if (value.isExt() && value.extType() >= 0)
+      writeHeader(CBOR_TAG, size_t(value.extType()));
+    writeHeader(CBOR_BYTE_STRING, value.size());
+    writeBytes(value.data(), value.size());
+    return bytesWritten();
+  }
+
+  size_t visitRawJson(const char* data, size_t size) {
+    writeBytes(reinterpret_cast<const uint8_t*>(data), size);
+    return bytesWritten();
+  }
+
+  size_t visitSignedInteger(JsonInteger value) {
+    if (value >= 0)
+      return visitUnsignedInteger(static_cast<JsonUInt>(value));
+    // -1 - value can't overflow, unlike -value
+    writeArgument(CBOR_NEGATIVE_INTEGER, static_cast<JsonUInt>(-1 - value));
+    return bytesWritten();
+  }
+
+  size_t visitUnsignedInteger(JsonUInt value) {
+    writeArgument(CBOR_UNSIGNED_INTEGER, value);
+    return bytesWritten();
+  }
+
+  size_t visitBoolean(bool value) {
+    writeByte(value ? 0xF5 : 0xF4);
+    return bytesWritten();
+  }
+
+  size_t visitNull() {
+    writeByte(0xF6);
+    return bytesWritten();
+  }
+
+ private:
+  size_t bytesWritten() const {
+    return writer_.count();
+  }
+
+  void writeByte(uint8_t c) {
+    writer_.write(c);
+  }
+
+  void writeBytes(const uint8_t* p, size_t n) {
+    writer_.write(p, n);
+  }
+
+  void writeHeader(CborMajorType type, size_t n) {
+    writeArgument(type, JsonUInt(n));
+  }
+
+  // Writes the initial byte followed by the argument in 0, 1, 2, 4, or 8
+  // bytes
+  void writeArgument(CborMajorType type, JsonUInt value) {
+    if (value < 24) {
+      writeByte(uint8_t(type | uint8_t(value)));
+    } else if (value <= 0xFF) {
+      writeByte(uint8_t(type | 24));
+      writeInteger(uint8_t(value));
+    } else if (value <= 0xFFFF) {
+      writeByte(uint8_t(type | 25));
+      writeInteger(uint16_t(value));
+    }
+#if ARDUINOJSON_USE_LONG_LONG
+    else if (value <= 0xFFFFFFFF)
+#else
+    else
+#endif
+    {
+      writeByte(uint8_t(type | 26));
+      writeInteger(uint32_t(value));
+    }
+#if ARDUINOJSON_USE_LONG_LONG
+    else {
+      writeByte(uint8_t(type | 27));
+      writeInteger(uint64_t(value));
+    }
+#endif
+  }
+
+  template <typename T>
+  void writeInteger(T value) {
+    fixEndianess(value);
+    writeBytes(reinterpret_cast<uint8_t*>(&value), sizeof(value));
+  }
+
+  CountingDecorator<TWriter> writer_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Produces a CBOR document (RFC 8949).
+template <typename TDestination>
+inline size_t serializeCbor(JsonVariantConst source, TDestination& output) {
+  using namespace ArduinoJson::detail;
+  return serialize<CborSerializer>(source, output);
+}
+
+// Produces a CBOR document (RFC 8949).
+inline size_t serializeCbor(JsonVariantConst source, void* output,
+                            size_t size) {
+  using namespace ArduinoJson::detail;
+  return serialize<CborSerializer>(source, output, size);
+}
+
+// Computes the length of the document that serializeCbor() produces.
+inline size_t measureCbor(JsonVariantConst source) {
+  using namespace ArduinoJson::detail;
+  return measure<CborSerializer>(source);
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -6,6 +6,7 @@
 
 #include <ArduinoJson/Namespace.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/integer.hpp>
 
 #include <stddef.h>  // size_t
 
@@ -15,9 +16,26 @@ class MemoryPool;
 class VariantData;
 class VariantSlot;
 
+typedef int_t<ARDUINOJSON_SLOT_OFFSET_SIZE * 8>::type VariantSlotDiff;
+
+#if ARDUINOJSON_STORE_COLLECTION_SIZE
+// The tail and the number of slots are packed in the space of a pointer, so
+// they don't depend on ARDUINOJSON_SLOT_OFFSET_SIZE
+typedef int_t<sizeof(void*) * 4>::type CollectionSlotDiff;
+typedef uint_t<sizeof(void*) * 4>::type CollectionSlotCount;
+#endif
+
 class CollectionData {
+  // addSlot() fails if the link to the new slot doesn't fit, or, with
+  // ARDUINOJSON_STORE_COLLECTION_SIZE, if the tail or the count doesn't.
   VariantSlot* head_;
+#if ARDUINOJSON_STORE_COLLECTION_SIZE
+  // packed in the space of a pointer, so that the slots don't grow
+  CollectionSlotDiff tail_;  // relative to head_
+  CollectionSlotCount size_;
+#else
   VariantSlot* tail_;
+#endif
 
  public:
   // Must be a POD!
@@ -34,7 +52,7 @@ class CollectionData {
 
   VariantData* getOrAddElement(size_t index, MemoryPool* pool);
 
-  void removeElement(size_t index);
+  void removeElement(size_t index, MemoryPool* pool);
 
   // Object only
 
@@ -48,8 +66,8 @@ class CollectionData {
   VariantData* getOrAddMember(TAdaptedString key, MemoryPool* pool);
 
   template <typename TAdaptedString>
-  void removeMember(TAdaptedString key) {
-    removeSlot(getSlot(key));
+  void removeMember(TAdaptedString key, MemoryPool* pool) {
+    removeSlot(getSlot(key), pool);
   }
 
   template <typename TAdaptedString>
@@ -62,7 +80,13 @@ class CollectionData {
   size_t size() const;
 
   VariantSlot* addSlot(MemoryPool*);
-  void removeSlot(VariantSlot* slot);
+  VariantSlot* addSlots(size_t n, MemoryPool*);
+  void removeSlot(VariantSlot* slot, MemoryPool* pool);
+  void removeSlotsAfter(VariantSlot* slot, MemoryPool* pool);
+
+  // Gives the slots and their strings back to the pool, without unlinking
+  // them; see MemoryPool::freeVariant()
+  void release(MemoryPool* pool);
 
   bool copyFrom(const CollectionData& src, MemoryPool* pool);
 
@@ -72,6 +96,12 @@ class CollectionData {
 
   void movePointers(ptrdiff_t stringDistance, ptrdiff_t variantDistance);
 
+  template <typename TMarker>
+  void mark(TMarker& marker) const;
+
+  template <typename TRelocator>
+  void relocate(const TRelocator& relocator);
+
  private:
   VariantSlot* getSlot(size_t index) const;
 
@@ -79,6 +109,14 @@ class CollectionData {
   VariantSlot* getSlot(TAdaptedString key) const;
 
   VariantSlot* getPreviousSlot(VariantSlot*) const;
+
+  bool canAppend(VariantSlot* first, VariantSlot* last, size_t n) const;
+
+  VariantSlot* tail() const;
+  void setTail(VariantSlot*);
+
+  // Adjusts the count of slots, if ARDUINOJSON_STORE_COLLECTION_SIZE
+  void addToSize(ptrdiff_t n);
 };
 
 inline const VariantData* collectionToVariant(
@@ -9,26 +9,95 @@
 #include <ArduinoJson/Strings/StringAdapters.hpp>
 #include <ArduinoJson/Variant/VariantData.hpp>
 
+#include <string.h>  // strlen
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
+template <typename T>
+inline bool slotDistanceFits(ptrdiff_t distance) {
+  return distance >= numeric_limits<T>::lowest() &&
+         distance <= numeric_limits<T>::highest();
+}
+
+// Tells whether the n slots from first to last can be linked after the tail.
+// This fails when the collection is full or when the pool is larger than the
+// range of the offsets (e.g., a big pool with ARDUINOJSON_SLOT_OFFSET_SIZE 1).
+inline bool CollectionData::canAppend(VariantSlot* first, VariantSlot* last,
+                                      size_t n) const {
+#if ARDUINOJSON_STORE_COLLECTION_SIZE
+  if (n > size_t(numeric_limits<CollectionSlotCount>::highest() - size_))
+    return false;
+  if (!head_)
+    return slotDistanceFits<CollectionSlotDiff>(last - first);
+  return slotDistanceFits<VariantSlotDiff>(first - tail()) &&
+         slotDistanceFits<CollectionSlotDiff>(last - head_);
+#else
+  (void)last;
+  (void)n;
+  return !head_ || slotDistanceFits<VariantSlotDiff>(first - tail_);
+#endif
+}
+
 inline VariantSlot* CollectionData::addSlot(MemoryPool* pool) {
   VariantSlot* slot = pool->allocVariant();
   if (!slot)
     return 0;
 
-  if (tail_) {
-    ARDUINOJSON_ASSERT(pool->owns(tail_));  // Can't alter a linked array/object
-    tail_->setNextNotNull(slot);
-    tail_ = slot;
+  if (!canAppend(slot, slot, 1)) {
+    pool->freeVariant(slot);
+    pool->markAsOverflowed();
+    return 0;
+  }
+
+  VariantSlot* tail = this->tail();
+  if (tail) {
+    ARDUINOJSON_ASSERT(pool->owns(tail));  // Can't alter a linked array/object
+    tail->setNextNotNull(slot);
   } else {
     head_ = slot;
-    tail_ = slot;
   }
+  setTail(slot);
+  addToSize(1);
 
   slot->clear();
   return slot;
 }
 
+// Appends n slots allocated in one block and linked in forward order.
+// Returns the first one, or null if the pool can't hold all of them.
+inline VariantSlot* CollectionData::addSlots(size_t n, MemoryPool* pool) {
+  ARDUINOJSON_ASSERT(n > 0);
+  VariantSlot* first = pool->allocVariants(n);
+  if (!first)
+    return 0;
+
+  VariantSlot* last = first + (n - 1);
+  if (!canAppend(first, last, n)) {
+    for (VariantSlot* slot = first; slot <= last; slot++)
+      pool->freeVariant(slot);
+    pool->markAsOverflowed();
+    return 0;
+  }
+
+  for (VariantSlot* slot = first; slot != last; slot++) {
+    slot->clear();
+    slot->setNextNotNull(slot + 1);
+  }
+  last->clear();
+
+  VariantSlot* tail = this->tail();
+  if (tail) {
+    ARDUINOJSON_ASSERT(pool->owns(tail));  // Can't alter a linked array/object
+    tail->setNextNotNull(first);
+  } else {
+    head_ = first;
+  }
+  setTail(last);
+  addToSize(ptrdiff_t(n));
+
+  return first;
+}
+
 inline VariantData* CollectionData::addElement(MemoryPool* pool) {
   return slotData(addSlot(pool));
 }
@@ -38,7 +107,7 @@ inline VariantData* CollectionData::addMember(TAdaptedString key,
                                               MemoryPool* pool) {
   VariantSlot* slot = addSlot(pool);
   if (!slotSetKey(slot, key, pool)) {
-    removeSlot(slot);
+    removeSlot(slot, pool);
     return 0;
   }
   return slot->data();
@@ -47,6 +116,9 @@ inline VariantData* CollectionData::addMember(TAdaptedString key,
 inline void CollectionData::clear() {
   head_ = 0;
   tail_ = 0;
+#if ARDUINOJSON_STORE_COLLECTION_SIZE
+  size_ = 0;
+#endif
 }
 
 template <typename TAdaptedString>
@@ -78,9 +150,12 @@ template <typename TAdaptedString>
 inline VariantSlot* CollectionData::getSlot(TAdaptedString key) const {
   if (key.isNull())
     return 0;
+  size_t size = key.size();
   VariantSlot* slot = head_;
   while (slot) {
-    if (stringEquals(key, adaptString(slot->key())))
+    // the keys of another size are skipped without reading them
+    if (slot->keySize() == size &&
+        stringEquals(key, adaptString(slot->key(), size)))
       break;
     slot = slot->next();
   }
@@ -88,8 +163,13 @@ inline VariantSlot* CollectionData::getSlot(TAdaptedString key) const {
 }
 
 inline VariantSlot* CollectionData::getSlot(size_t index) const {
+#if ARDUINOJSON_STORE_COLLECTION_SIZE
+  if (index >= size_)  // without walking the list
+    return 0;
+#else
   if (!head_)
     return 0;
+#endif
   return head_->next(index);
 }
 
@@ -132,51 +212,131 @@ inline VariantData* CollectionData::getElement(size_t index) const {
 
 inline VariantData* CollectionData::getOrAddElement(size_t index,
                                                     MemoryPool* pool) {
-  VariantSlot* slot = head_;
-  while (slot && index > 0) {
-    slot = slot->next();
-    index--;
-  }
-  if (!slot)
-    index++;
-  while (index > 0) {
+  size_t size = this->size();
+  if (index < size)
+    return getElement(index);
+  // appends the missing elements after the tail
+  VariantSlot* slot = 0;
+  for (size_t n = index - size + 1; n > 0; n--) {
     slot = addSlot(pool);
-    index--;
+    if (!slot)
+      return 0;
   }
   return slotData(slot);
 }
 
-inline void CollectionData::removeSlot(VariantSlot* slot) {
+// Gives the slot, its key, and its value back to the pool.
+// Does nothing if the slot isn't in the pool (e.g., after shallowCopy()).
+inline void releaseSlot(VariantSlot* slot, MemoryPool* pool) {
+  if (!pool || !pool->owns(slot))
+    return;
+  size_t keySize;
+  const char* keyBytes = slot->keyBytes(&keySize);
+  if (keyBytes)
+    pool->freeString(keyBytes, keySize);
+  slot->data()->release(pool);
+  pool->freeVariant(slot);
+}
+
+inline void CollectionData::release(MemoryPool* pool) {
+  VariantSlot* slot = head_;
+  while (slot) {
+    VariantSlot* next = slot->next();  // before the slot is overwritten
+    releaseSlot(slot, pool);
+    slot = next;
+  }
+}
+
+inline void CollectionData::removeSlot(VariantSlot* slot, MemoryPool* pool) {
   if (!slot)
     return;
   VariantSlot* prev = getPreviousSlot(slot);
   VariantSlot* next = slot->next();
+  VariantSlot* tail = next ? this->tail() : prev;
   if (prev)
     prev->setNext(next);
   else
     head_ = next;
-  if (!next)
-    tail_ = prev;
+  setTail(tail);
+  addToSize(-1);
+  releaseSlot(slot, pool);
 }
 
-inline void CollectionData::removeElement(size_t index) {
-  removeSlot(getSlot(index));
+// Removes the slots that follow the specified one, or all slots if null
+inline void CollectionData::removeSlotsAfter(VariantSlot* slot,
+                                             MemoryPool* pool) {
+  VariantSlot* removed = slot ? slot->next() : head_;
+  while (removed) {
+    VariantSlot* next = removed->next();
+    releaseSlot(removed, pool);
+    removed = next;
+    addToSize(-1);
+  }
+  if (slot) {
+    slot->setNext(0);
+    setTail(slot);
+  } else {
+    clear();
+  }
+}
+
+inline void CollectionData::removeElement(size_t index, MemoryPool* pool) {
+  removeSlot(getSlot(index), pool);
 }
 
 inline size_t CollectionData::memoryUsage() const {
   size_t total = 0;
   for (VariantSlot* s = head_; s; s = s->next()) {
     total += sizeof(VariantSlot) + s->data()->memoryUsage();
-    if (s->ownsKey())
-      total += strlen(s->key()) + 1;
+    size_t keySize;
+    if (s->keyBytes(&keySize))
+      total += keySize;
   }
   return total;
 }
 
 inline size_t CollectionData::size() const {
-  return slotSize(head_);
+#if ARDUINOJSON_STORE_COLLECTION_SIZE
+  return size_;
+#else
+  size_t n = 0;
+  for (VariantSlot* slot = head_; slot; slot = slot->next())
+    n++;
+  return n;
+#endif
+}
+
+#if ARDUINOJSON_STORE_COLLECTION_SIZE
+
+inline VariantSlot* CollectionData::tail() const {
+  return head_ ? head_ + tail_ : 0;
+}
+
+inline void CollectionData::setTail(VariantSlot* slot) {
+  ARDUINOJSON_ASSERT(!slot || head_);
+  ARDUINOJSON_ASSERT(
+      !slot || slotDistanceFits<CollectionSlotDiff>(slot - head_));
+  tail_ = CollectionSlotDiff(slot ? slot - head_ : 0);
+}
+
+inline void CollectionData::addToSize(ptrdiff_t n) {
+  size_ = CollectionSlotCount(ptrdiff_t(size_) + n);
+}
+
+#else
+
+inline VariantSlot* CollectionData::tail() const {
+  return tail_;
+}
+
+inline void CollectionData::setTail(VariantSlot* slot) {
+  tail_ = slot;
 }
 
+inline void CollectionData::addToSize(ptrdiff_t) {}
+
+#endif
+
 template <typename T>
 inline void movePointer(T*& p, ptrdiff_t offset) {
   if (!p)
@@ -189,9 +349,32 @@ inline void movePointer(T*& p, ptrdiff_t offset) {
 inline void CollectionData::movePointers(ptrdiff_t stringDistance,
                                          ptrdiff_t variantDistance) {
   movePointer(head_, variantDistance);
-  movePointer(tail_, variantDistance);
+#if !ARDUINOJSON_STORE_COLLECTION_SIZE
+  movePointer(tail_, variantDistance);  // otherwise, relative to head_
+#endif
   for (VariantSlot* slot = head_; slot; slot = slot->next())
     slot->movePointers(stringDistance, variantDistance);
 }
 
+template <typename TMarker>
+inline void CollectionData::mark(TMarker& marker) const {
+  for (VariantSlot* slot = head_; slot; slot = slot->next()) {
+    // stops at a slot already marked (shallowCopy()) or outside of the pool
+    if (!marker.markSlot(slot))
+      return;
+    size_t keySize;
+    const char* keyBytes = slot->keyBytes(&keySize);
+    if (keyBytes)
+      marker.markString(keyBytes, keySize);
+    slot->data()->mark(marker);
+  }
+}
+
+template <typename TRelocator>
+inline void CollectionData::relocate(const TRelocator& relocator) {
+  VariantSlot* tail = this->tail();  // before head_ moves
+  head_ = relocator.newAddress(head_);
+  setTail(relocator.newAddress(tail));
+}
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -54,6 +54,22 @@
 #  endif
 #endif
 
+// Support std::mutex, see JsonDocumentPool
+// (off on Arduino, where the toolchains often lack thread support)
+#ifndef ARDUINOJSON_ENABLE_STD_MUTEX
+#  ifdef ARDUINO
+#    define ARDUINOJSON_ENABLE_STD_MUTEX 0
+#  elif defined(__has_include)
+#    if __has_include(<mutex>) && !defined(min) && !defined(max)
+#      define ARDUINOJSON_ENABLE_STD_MUTEX 1
+#    else
+#      define ARDUINOJSON_ENABLE_STD_MUTEX 0
+#    endif
+#  else
+#    define ARDUINOJSON_ENABLE_STD_MUTEX 1
+#  endif
+#endif
+
 // Store floating-point values with float (0) or double (1)
 #ifndef ARDUINOJSON_USE_DOUBLE
 #  define ARDUINOJSON_USE_DOUBLE 1
@@ -75,14 +91,30 @@
 #  define ARDUINOJSON_DEFAULT_NESTING_LIMIT 10
 #endif
 
+// Store the keys as 32-bit offsets from their slot instead of pointers
+// (saves RAM on 64-bit platforms: 24-byte slots instead of 32, but a linked
+// key takes the room of a pointer in the pool, the pool must be less than
+// 2 GB, and ARDUINOJSON_SLOT_OFFSET_SIZE defaults to 2 like on 32-bit)
+#ifndef ARDUINOJSON_COMPACT_SLOTS
+#  define ARDUINOJSON_COMPACT_SLOTS 0
+#endif
+
+// Store the short strings in the variant instead of the memory pool
+// (saves RAM and an indirection, but the strings and their pointers move with
+// the variant; up to 15 characters on 64-bit platforms, 7 on 32-bit)
+#ifndef ARDUINOJSON_INLINE_SHORT_STRINGS
+#  define ARDUINOJSON_INLINE_SHORT_STRINGS 0
+#endif
+
 // Number of bits to store the pointer to next node
 // (saves RAM but limits the number of values in a document)
 #ifndef ARDUINOJSON_SLOT_OFFSET_SIZE
 #  if defined(__SIZEOF_POINTER__) && __SIZEOF_POINTER__ <= 2
 // Address space == 16-bit => max 127 values
 #    define ARDUINOJSON_SLOT_OFFSET_SIZE 1
-#  elif defined(__SIZEOF_POINTER__) && __SIZEOF_POINTER__ >= 8 || \
-      defined(_WIN64) && _WIN64
+#  elif (defined(__SIZEOF_POINTER__) && __SIZEOF_POINTER__ >= 8 || \
+         defined(_WIN64) && _WIN64) &&                            \
+      !ARDUINOJSON_COMPACT_SLOTS
 // Address space == 64-bit => max 2147483647 values
 #    define ARDUINOJSON_SLOT_OFFSET_SIZE 4
 #  else
@@ -91,6 +123,29 @@
 #  endif
 #endif
 
+// Store the size of the keys in the slots, so that the lookups skip the keys
+// of another size without reading them (uses the padding before the offset
+// to the next slot, so it's off when the offset is a single byte)
+#ifndef ARDUINOJSON_STORE_KEY_SIZE
+#  if ARDUINOJSON_SLOT_OFFSET_SIZE >= 2
+#    define ARDUINOJSON_STORE_KEY_SIZE 1
+#  else
+#    define ARDUINOJSON_STORE_KEY_SIZE 0
+#  endif
+#endif
+
+// Store the number of values in arrays and objects, so that size() doesn't
+// walk the list (the count is packed with the tail in the space of a pointer,
+// which limits both to half a pointer, so it's only on for 64-bit platforms)
+#ifndef ARDUINOJSON_STORE_COLLECTION_SIZE
+#  if defined(__SIZEOF_POINTER__) && __SIZEOF_POINTER__ >= 8 || \
+      defined(_WIN64) && _WIN64
+#    define ARDUINOJSON_STORE_COLLECTION_SIZE 1
+#  else
+#    define ARDUINOJSON_STORE_COLLECTION_SIZE 0
+#  endif
+#endif
+
 #ifdef ARDUINO
 
 // Enable support for Arduino's String class
@@ -203,6 +258,17 @@
 #  define ARDUINOJSON_STRING_BUFFER_SIZE 32
 #endif
 
+// Capacity of the temporary pool used by the typed overloads of extractJson()
+#ifndef ARDUINOJSON_EXTRACTION_BUFFER_SIZE
+#  define ARDUINOJSON_EXTRACTION_BUFFER_SIZE 256
+#endif
+
+// Capacity of the temporary pool used by transcodeJsonToMsgPack() and
+// transcodeMsgPackToJson(), which limits the length of the strings
+#ifndef ARDUINOJSON_TRANSCODING_BUFFER_SIZE
+#  define ARDUINOJSON_TRANSCODING_BUFFER_SIZE 256
+#endif
+
 #ifndef ARDUINOJSON_DEBUG
 #  ifdef __PLATFORMIO_BUILD_DEBUG__
 #    define ARDUINOJSON_DEBUG 1
@@ -0,0 +1,57 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+// Stores the selected values verbatim, as if they were set with serialized(),
+// so that serializeJson() writes them back byte-for-byte.
+// In the paths, true selects a value; objects select members ("*" matches any
+// key), arrays select elements (the first element applies to all elements).
+// With a mutable input (char*), the values stay in the input; otherwise, they
+// are copied to the pool.
+class CaptureRaw {
+ public:
+  explicit CaptureRaw(JsonVariantConst paths) : paths_(paths) {}
+
+  bool allow() const {
+    return true;
+  }
+
+  bool allowArray() const {
+    return true;
+  }
+
+  bool allowObject() const {
+    return true;
+  }
+
+  bool allowValue() const {
+    return true;
+  }
+
+  bool deferred() const {
+    return false;
+  }
+
+  bool captured() const {
+    return paths_ == true;
+  }
+
+  template <typename TKey>
+  CaptureRaw operator[](const TKey& key) const {
+    JsonVariantConst member = paths_[key];
+    return CaptureRaw(member.isNull() ? paths_["*"] : member);
+  }
+
+ private:
+  JsonVariantConst paths_;
+};
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
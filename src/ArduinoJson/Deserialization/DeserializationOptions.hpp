@@ -4,32 +4,142 @@
 
 #pragma once
 
+#include <ArduinoJson/Deserialization/CaptureRaw.hpp>
+#include <ArduinoJson/Deserialization/DeserializationStats.hpp>
 #include <ArduinoJson/Deserialization/Filter.hpp>
+#include <ArduinoJson/Deserialization/Lazy.hpp>
 #include <ArduinoJson/Deserialization/NestingLimit.hpp>
+#include <ArduinoJson/Deserialization/ZeroCopy.hpp>
+#include <ArduinoJson/Misc/KeyDictionary.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
-template <typename TFilter>
+template <typename TFilter, typename TStats = NoDeserializationStats,
+          typename TZeroCopy = NoZeroCopy>
 struct DeserializationOptions {
   TFilter filter;
   DeserializationOption::NestingLimit nestingLimit;
+  TStats stats;
+  TZeroCopy zeroCopy;
+  KeyDictionary keys;
 };
 
-template <typename TFilter>
-inline DeserializationOptions<TFilter> makeDeserializationOptions(
-    TFilter filter, DeserializationOption::NestingLimit nestingLimit = {}) {
-  return {filter, nestingLimit};
+// The options can be passed in any order.
+// The filter is the argument that isn't one of these options.
+template <typename T>
+struct IsDeserializationOption : false_type {};
+
+template <>
+struct IsDeserializationOption<DeserializationOption::NestingLimit>
+    : true_type {};
+
+template <>
+struct IsDeserializationOption<DeserializationStats*> : true_type {};
+
+template <>
+struct IsDeserializationOption<DeserializationOption::ZeroCopy> : true_type {};
+
+template <>
+struct IsDeserializationOption<KeyDictionary> : true_type {};
+
+template <typename...>
+struct DeserializationFilterType {
+  using type = AllowAllFilter;
+};
+
+template <typename T, typename... Rest>
+struct DeserializationFilterType<T, Rest...> {
+  using type = typename conditional<
+      IsDeserializationOption<T>::value,
+      typename DeserializationFilterType<Rest...>::type, T>::type;
+};
+
+// Returns TOption if it's one of Args, TDefault otherwise
+template <typename TOption, typename TDefault, typename...>
+struct DeserializationOptionType {
+  using type = TDefault;
+};
+
+template <typename TOption, typename TDefault, typename T, typename... Rest>
+struct DeserializationOptionType<TOption, TDefault, T, Rest...>
+    : DeserializationOptionType<TOption, TDefault, Rest...> {};
+
+template <typename TOption, typename TDefault, typename... Rest>
+struct DeserializationOptionType<TOption, TDefault, TOption, Rest...> {
+  using type = TOption;
+};
+
+inline AllowAllFilter extractFilter() {
+  return AllowAllFilter();
+}
+
+template <typename T, typename... Rest>
+typename enable_if<!IsDeserializationOption<T>::value, T>::type extractFilter(
+    T filter, Rest...) {
+  return filter;
 }
 
-template <typename TFilter>
-inline DeserializationOptions<TFilter> makeDeserializationOptions(
-    DeserializationOption::NestingLimit nestingLimit, TFilter filter) {
-  return {filter, nestingLimit};
+template <typename T, typename... Rest>
+typename enable_if<IsDeserializationOption<T>::value,
+                   typename DeserializationFilterType<Rest...>::type>::type
+extractFilter(T, Rest... rest) {
+  return extractFilter(rest...);
 }
 
-inline DeserializationOptions<AllowAllFilter> makeDeserializationOptions(
-    DeserializationOption::NestingLimit nestingLimit = {}) {
-  return {{}, nestingLimit};
+template <typename TOptions>
+inline void applyOption(TOptions& options,
+                        DeserializationOption::NestingLimit nestingLimit) {
+  options.nestingLimit = nestingLimit;
+}
+
+template <typename TOptions>
+inline void applyOption(TOptions& options, DeserializationStats* stats) {
+  options.stats = stats;
+}
+
+template <typename TOptions>
+inline void applyOption(TOptions& options,
+                        DeserializationOption::ZeroCopy zeroCopy) {
+  options.zeroCopy = zeroCopy;
+}
+
+template <typename TOptions>
+inline void applyOption(TOptions& options, KeyDictionary keys) {
+  options.keys = keys;
+}
+
+template <typename TOptions, typename TFilter>
+inline void applyOption(TOptions&, TFilter) {
+  // the filter is set by extractFilter()
+}
+
+template <typename TOptions>
+inline void applyOptions(TOptions&) {}
+
+template <typename TOptions, typename T, typename... Rest>
+inline void applyOptions(TOptions& options, T arg, Rest... rest) {
+  applyOption(options, arg);
+  applyOptions(options, rest...);
+}
+
+template <typename... Args>
+struct DeserializationOptionsType {
+  using type = DeserializationOptions<
+      typename DeserializationFilterType<Args...>::type,
+      typename DeserializationOptionType<DeserializationStats*,
+                                         NoDeserializationStats, Args...>::type,
+      typename DeserializationOptionType<DeserializationOption::ZeroCopy,
+                                         NoZeroCopy, Args...>::type>;
+};
+
+template <typename... Args>
+inline typename DeserializationOptionsType<Args...>::type
+makeDeserializationOptions(Args... args) {
+  typename DeserializationOptionsType<Args...>::type options = {
+      extractFilter(args...), {}, {}, {}, {}};
+  applyOptions(options, args...);
+  return options;
 }
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
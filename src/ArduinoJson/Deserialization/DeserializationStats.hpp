@@ -0,0 +1,215 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/Reader.hpp>
+#include <ArduinoJson/Deserialization/ZeroCopy.hpp>
+#include <ArduinoJson/Strings/JsonString.hpp>
+
+#include <stddef.h>  // size_t
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Statistics about one call to deserializeJson() or deserializeMsgPack().
+// Pass a pointer to this structure as an extra argument to fill it, e.g.
+//   deserializeJson(doc, input, &stats);
+// Nothing is collected (and no code is generated) when it's not requested.
+struct DeserializationStats {
+  // The clock measures the time spent in strings and numbers (e.g. micros).
+  // Without a clock, stringTime and numberTime remain zero.
+  explicit DeserializationStats(unsigned long (*clk)() = 0)
+      : bytesRead(0),
+        slots(0),
+        stringBytes(0),
+        dedupHits(0),
+        dedupMisses(0),
+        maxDepth(0),
+        bytesSkipped(0),
+        stringTime(0),
+        numberTime(0),
+        clock(clk) {}
+
+  size_t bytesRead;     // including one character of look-ahead for JSON
+  size_t slots;         // variant slots allocated in the pool
+  size_t stringBytes;   // copied to the pool, including the terminators
+  size_t dedupHits;     // strings that were already in the pool
+  size_t dedupMisses;   // strings copied to the pool
+  size_t maxDepth;      // nesting of the resulting document
+  size_t bytesSkipped;  // values rejected by the filter, see bytesRead
+  unsigned long stringTime;
+  unsigned long numberTime;
+  unsigned long (*clock)();
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The type of DeserializationOptions::stats when no stats are requested
+struct NoDeserializationStats {};
+
+// Counts the bytes read from the input
+template <typename TReader>
+class StatsReader {
+ public:
+  StatsReader(TReader reader, DeserializationStats* stats)
+      : reader_(reader), stats_(stats) {}
+
+  int read() {
+    int c = reader_.read();
+    if (c >= 0)
+      stats_->bytesRead++;
+    return c;
+  }
+
+  size_t readBytes(char* buffer, size_t length) {
+    size_t n = reader_.readBytes(buffer, length);
+    stats_->bytesRead += n;
+    return n;
+  }
+
+  size_t skip(size_t n) {
+    size_t skipped = skipInput(reader_, n);
+    stats_->bytesRead += skipped;
+    return skipped;
+  }
+
+  const char* readInPlace(size_t n) {
+    const char* s = detail::readInPlace(reader_, n);
+    if (s)
+      stats_->bytesRead += n;
+    return s;
+  }
+
+ private:
+  TReader reader_;
+  DeserializationStats* stats_;
+};
+
+template <typename TReader>
+StatsReader<TReader> makeStatsReader(TReader reader,
+                                     DeserializationStats* stats) {
+  return StatsReader<TReader>(reader, stats);
+}
+
+template <typename TReader>
+const char* readInPlace(StatsReader<TReader>& reader, size_t n) {
+  return reader.readInPlace(n);
+}
+
+// Counts the strings saved by the deserializer, and whether they were
+// deduplicated. It also gives access to the stats to StatsTimer and
+// SkipCounter.
+template <typename TStringStorage>
+class StatsStringStorage {
+ public:
+  StatsStringStorage(TStringStorage storage, DeserializationStats* stats)
+      : storage_(storage), stats_(stats) {}
+
+  void startString() {
+    storage_.startString();
+  }
+
+  JsonString save() {
+    const char* candidate = storage_.str().c_str();
+    JsonString s = storage_.save();
+    if (!s.isLinked()) {
+      if (s.c_str() == candidate) {
+        stats_->dedupMisses++;
+        stats_->stringBytes += s.size() + 1;
+      } else {
+        stats_->dedupHits++;
+      }
+    }
+    return s;
+  }
+
+  void append(char c) {
+    storage_.append(c);
+  }
+
+  template <typename TReader>
+  bool appendFrom(TReader& reader, size_t n) {
+    return storage_.appendFrom(reader, n);
+  }
+
+  bool isValid() const {
+    return storage_.isValid();
+  }
+
+  size_t size() const {
+    return storage_.size();
+  }
+
+  JsonString str() const {
+    return storage_.str();
+  }
+
+  DeserializationStats* stats() const {
+    return stats_;
+  }
+
+ private:
+  TStringStorage storage_;
+  DeserializationStats* stats_;
+};
+
+// Adds the time spent in the current scope to one of the counters.
+// Does nothing unless the deserializer collects stats and a clock is set.
+template <typename TStringStorage>
+class StatsTimer {
+ public:
+  StatsTimer(const TStringStorage&, unsigned long DeserializationStats::*) {}
+};
+
+template <typename TStringStorage>
+class StatsTimer<StatsStringStorage<TStringStorage>> {
+ public:
+  StatsTimer(const StatsStringStorage<TStringStorage>& storage,
+             unsigned long DeserializationStats::*counter)
+      : stats_(storage.stats()), counter_(counter), start_(0) {
+    if (stats_->clock)
+      start_ = stats_->clock();
+  }
+
+  ~StatsTimer() {
+    if (stats_->clock)
+      stats_->*counter_ += stats_->clock() - start_;
+  }
+
+ private:
+  DeserializationStats* stats_;
+  unsigned long DeserializationStats::*counter_;
+  unsigned long start_;
+};
+
+// Adds the bytes read in the current scope to bytesSkipped, plus the bytes
+// that the deserializer already read ahead.
+// Does nothing unless the deserializer collects stats.
+template <typename TStringStorage>
+class SkipCounter {
+ public:
+  SkipCounter(const TStringStorage&, bool, size_t) {}
+};
+
+template <typename TStringStorage>
+class SkipCounter<StatsStringStorage<TStringStorage>> {
+ public:
+  SkipCounter(const StatsStringStorage<TStringStorage>& storage, bool enabled,
+              size_t readAhead)
+      : stats_(enabled ? storage.stats() : 0),
+        start_(stats_ ? stats_->bytesRead - readAhead : 0) {}
+
+  ~SkipCounter() {
+    if (stats_)
+      stats_->bytesSkipped += stats_->bytesRead - start_;
+  }
+
+ private:
+  DeserializationStats* stats_;
+  size_t start_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -29,6 +29,14 @@ class Filter {
     return variant_ == true;
   }
 
+  bool deferred() const {
+    return false;
+  }
+
+  bool captured() const {
+    return false;
+  }
+
   template <typename TKey>
   Filter operator[](const TKey& key) const {
     if (variant_ == true)  // "true" means "allow recursively"
@@ -60,11 +68,34 @@ struct AllowAllFilter {
     return true;
   }
 
+  bool deferred() const {
+    return false;
+  }
+
+  bool captured() const {
+    return false;
+  }
+
   template <typename TKey>
   AllowAllFilter operator[](const TKey&) const {
     return AllowAllFilter();
   }
 };
+
+// Returns true if the filter allows every member of an object, so the
+// deserializer can reserve the slots before reading the keys
+template <typename TFilter>
+inline bool allowsAllMembers(const TFilter&) {
+  return false;
+}
+
+inline bool allowsAllMembers(const AllowAllFilter&) {
+  return true;
+}
+
+inline bool allowsAllMembers(const DeserializationOption::Filter& filter) {
+  return filter.allowValue();  // "true" means "allow recursively"
+}
 }  // namespace detail
 
 ARDUINOJSON_END_PUBLIC_NAMESPACE
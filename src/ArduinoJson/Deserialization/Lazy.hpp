@@ -0,0 +1,58 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+// Parses only the first levels of the document.
+// Deeper arrays and objects are stored verbatim and parsed on first access
+// through a mutable reference (e.g. doc["a"]["b"], doc["a"].size(), or
+// as<JsonObject>()), including a JsonVariantConst obtained from one.
+// Read-only views of a const document, or of a JsonArrayConst or
+// JsonObjectConst, cannot parse them and see them as raw JSON.
+// With a mutable input (char*), the verbatim text stays in the input, which
+// must remain alive; with a read-only input, it's copied to the pool.
+class Lazy {
+ public:
+  explicit Lazy(uint8_t depth = 1) : depth_(depth) {}
+
+  bool allow() const {
+    return true;
+  }
+
+  bool allowArray() const {
+    return true;
+  }
+
+  bool allowObject() const {
+    return true;
+  }
+
+  bool allowValue() const {
+    return true;
+  }
+
+  bool deferred() const {
+    return depth_ == 0;
+  }
+
+  bool captured() const {
+    return false;
+  }
+
+  template <typename TKey>
+  Lazy operator[](const TKey&) const {
+    return Lazy(depth_ > 0 ? static_cast<uint8_t>(depth_ - 1) : 0);
+  }
+
+ private:
+  uint8_t depth_;
+};
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
 #include <ArduinoJson/Polyfills/utility.hpp>
 
 #include <stdlib.h>  // for size_t
@@ -61,6 +62,45 @@ ARDUINOJSON_END_PRIVATE_NAMESPACE
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
+// Readers may implement skip(n), which returns the number of bytes skipped
+template <typename TReader, typename Enable = void>
+struct ReaderHasSkip : false_type {};
+
+template <typename TReader>
+struct ReaderHasSkip<
+    TReader,
+    typename make_void<decltype(declval<TReader&>().skip(size_t()))>::type>
+    : true_type {};
+
+// Skips n bytes of the input.
+// Returns the number of bytes skipped, less than n if the input ended.
+template <typename TReader>
+typename enable_if<ReaderHasSkip<TReader>::value, size_t>::type skipInput(
+    TReader& reader, size_t n) {
+  return reader.skip(n);
+}
+
+template <typename TReader>
+typename enable_if<!ReaderHasSkip<TReader>::value, size_t>::type skipInput(
+    TReader& reader, size_t n) {
+  size_t skipped = 0;
+  while (skipped < n && reader.read() >= 0)
+    skipped++;
+  return skipped;
+}
+
+// Readers of inputs in memory implement readInPlace(n).
+// A copy of such a reader reads the input independently of the original,
+// whereas copies of a stream reader consume the same stream.
+template <typename TReader, typename Enable = void>
+struct IsInMemoryReader : false_type {};
+
+template <typename TReader>
+struct IsInMemoryReader<TReader,
+                        typename make_void<decltype(
+                            declval<TReader&>().readInPlace(size_t()))>::type>
+    : true_type {};
+
 template <typename TInput>
 Reader<typename remove_reference<TInput>::type> makeReader(TInput&& input) {
   return Reader<typename remove_reference<TInput>::type>{
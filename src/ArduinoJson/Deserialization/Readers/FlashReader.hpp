@@ -25,6 +25,11 @@ struct Reader<const __FlashStringHelper*, void> {
     ptr_ += length;
     return length;
   }
+
+  size_t skip(size_t n) {
+    ptr_ += n;
+    return n;
+  }
 };
 
 template <>
@@ -51,6 +56,14 @@ struct BoundedReader<const __FlashStringHelper*, void> {
     ptr_ += length;
     return length;
   }
+
+  size_t skip(size_t n) {
+    size_t available = static_cast<size_t>(end_ - ptr_);
+    if (available < n)
+      n = available;
+    ptr_ += n;
+    return n;
+  }
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
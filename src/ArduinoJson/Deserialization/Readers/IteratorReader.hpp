@@ -27,6 +27,23 @@ class IteratorReader {
       buffer[i++] = *ptr_++;
     return i;
   }
+
+  size_t skip(size_t n) {
+    size_t available = size_t(end_ - ptr_);
+    if (n > available)
+      n = available;
+    ptr_ += static_cast<ptrdiff_t>(n);
+    return n;
+  }
+
+  // Only for contiguous containers, see DeserializationOption::ZeroCopy
+  const char* readInPlace(size_t n) {
+    if (n == 0 || n > size_t(end_ - ptr_))
+      return 0;
+    const char* s = &*ptr_;
+    ptr_ += static_cast<ptrdiff_t>(n);
+    return s;
+  }
 };
 
 template <typename T>
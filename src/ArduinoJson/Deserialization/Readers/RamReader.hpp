@@ -6,6 +6,8 @@
 
 #include <ArduinoJson/Polyfills/type_traits.hpp>
 
+#include <string.h>  // for memcpy
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 template <typename T>
@@ -32,20 +34,63 @@ struct Reader<TSource*,
   }
 
   size_t readBytes(char* buffer, size_t length) {
-    for (size_t i = 0; i < length; i++)
-      buffer[i] = *ptr_++;
+    memcpy(buffer, ptr_, length);
+    ptr_ += length;
     return length;
   }
+
+  size_t skip(size_t n) {
+    ptr_ += n;
+    return n;
+  }
+
+  const char* readInPlace(size_t n) {
+    const char* s = ptr_;
+    ptr_ += n;
+    return s;
+  }
 };
 
 template <typename TSource>
 struct BoundedReader<TSource*,
-                     typename enable_if<IsCharOrVoid<TSource>::value>::type>
-    : public IteratorReader<const char*> {
+                     typename enable_if<IsCharOrVoid<TSource>::value>::type> {
+  const char *ptr_, *end_;
+
  public:
   explicit BoundedReader(const void* ptr, size_t len)
-      : IteratorReader<const char*>(reinterpret_cast<const char*>(ptr),
-                                    reinterpret_cast<const char*>(ptr) + len) {}
+      : ptr_(reinterpret_cast<const char*>(ptr)), end_(ptr_ + len) {}
+
+  int read() {
+    if (ptr_ < end_)
+      return static_cast<unsigned char>(*ptr_++);
+    else
+      return -1;
+  }
+
+  size_t readBytes(char* buffer, size_t length) {
+    size_t available = size_t(end_ - ptr_);
+    if (length > available)
+      length = available;
+    memcpy(buffer, ptr_, length);
+    ptr_ += length;
+    return length;
+  }
+
+  size_t skip(size_t n) {
+    size_t available = size_t(end_ - ptr_);
+    if (n > available)
+      n = available;
+    ptr_ += n;
+    return n;
+  }
+
+  const char* readInPlace(size_t n) {
+    if (n > size_t(end_ - ptr_))
+      return 0;
+    const char* s = ptr_;
+    ptr_ += n;
+    return s;
+  }
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
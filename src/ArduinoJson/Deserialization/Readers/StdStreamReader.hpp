@@ -23,6 +23,11 @@ struct Reader<TSource, typename enable_if<
     return static_cast<size_t>(stream_->gcount());
   }
 
+  size_t skip(size_t n) {
+    stream_->ignore(static_cast<std::streamsize>(n));
+    return static_cast<size_t>(stream_->gcount());
+  }
+
  private:
   std::istream* stream_;
 };
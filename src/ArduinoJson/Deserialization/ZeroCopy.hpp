@@ -0,0 +1,69 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/StringStorage/StringStorage.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+// Stores MessagePack string values as pointers to the input instead of
+// copying them to the pool. The input must be in memory (e.g. const uint8_t*,
+// std::string) and must remain alive as long as the document uses it.
+// Since these strings are not null-terminated, as<const char*>() returns null
+// for them (use as<JsonString>() or as<std::string>() instead), and they
+// aren't converted to numbers.
+// Keys are still copied, and deserializeJson() ignores this option.
+class ZeroCopy {};
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The type of DeserializationOptions::zeroCopy when it's not requested
+struct NoZeroCopy {};
+
+// Gives the deserializer direct access to the input
+template <typename TReader>
+class ZeroCopyReader : public TReader {
+ public:
+  explicit ZeroCopyReader(TReader reader) : TReader(reader) {}
+};
+
+// Returns a pointer to the next n bytes of the input and skips them.
+// Returns null if the reader must copy them instead.
+template <typename TReader>
+const char* readInPlace(TReader&, size_t) {
+  return 0;
+}
+
+template <typename TReader>
+const char* readInPlace(ZeroCopyReader<TReader>& reader, size_t n) {
+  // Error here? DeserializationOption::ZeroCopy requires an input in memory
+  return reader.readInPlace(n);
+}
+
+template <typename TReader, typename TStringStorage>
+TReader makeZeroCopyReader(TReader reader, NoZeroCopy, TStringStorage&) {
+  return reader;
+}
+
+template <typename TReader>
+ZeroCopyReader<TReader> makeZeroCopyReader(TReader reader,
+                                           DeserializationOption::ZeroCopy,
+                                           StringCopier&) {
+  return ZeroCopyReader<TReader>(reader);
+}
+
+// With a mutable input, the strings are already stored in place, and linking
+// them would be unsafe because StringMover overwrites the input.
+template <typename TReader>
+TReader makeZeroCopyReader(TReader reader, DeserializationOption::ZeroCopy,
+                           StringMover&) {
+  return reader;
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -32,6 +32,59 @@ TDeserializer<TReader, TWriter> makeDeserializer(MemoryPool* pool,
   return TDeserializer<TReader, TWriter>(pool, reader, writer);
 }
 
+template <template <typename, typename> class TDeserializer, typename TReader,
+          typename TWriter>
+TDeserializer<TReader, TWriter> makeDeserializer(MemoryPool* pool,
+                                                 TReader reader,
+                                                 TWriter writer,
+                                                 KeyDictionary keys) {
+  TDeserializer<TReader, TWriter> deserializer =
+      makeDeserializer<TDeserializer>(pool, reader, writer);
+  deserializer.setKeyDictionary(keys);
+  return deserializer;
+}
+
+template <template <typename, typename> class TDeserializer, typename TReader,
+          typename TStringStorage, typename TFilter, typename TZeroCopy>
+DeserializationError parseWithOptions(
+    MemoryPool* pool, TReader reader, TStringStorage stringStorage,
+    VariantData& data,
+    DeserializationOptions<TFilter, NoDeserializationStats, TZeroCopy>
+        options) {
+  return makeDeserializer<TDeserializer>(
+             pool, makeZeroCopyReader(reader, options.zeroCopy, stringStorage),
+             stringStorage, options.keys)
+      .parse(data, options.filter, options.nestingLimit);
+}
+
+// Same as above, but wraps the reader and the string storage to collect
+// the stats
+template <template <typename, typename> class TDeserializer, typename TReader,
+          typename TStringStorage, typename TFilter, typename TZeroCopy>
+DeserializationError parseWithOptions(
+    MemoryPool* pool, TReader reader, TStringStorage stringStorage,
+    VariantData& data,
+    DeserializationOptions<TFilter, DeserializationStats*, TZeroCopy> options) {
+  DeserializationStats* stats = options.stats;
+  *stats = DeserializationStats(stats->clock);
+  size_t poolSize = pool->size();
+
+  DeserializationError err =
+      makeDeserializer<TDeserializer>(
+          pool,
+          makeStatsReader(
+              makeZeroCopyReader(reader, options.zeroCopy, stringStorage),
+              stats),
+          StatsStringStorage<TStringStorage>(stringStorage, stats),
+          options.keys)
+          .parse(data, options.filter, options.nestingLimit);
+
+  stats->slots = (pool->size() - poolSize - stats->stringBytes) /
+                 sizeof(VariantSlot);
+  stats->maxDepth = variantNesting(&data);
+  return err;
+}
+
 template <template <typename, typename> class TDeserializer, typename TStream,
           typename... Args,
           typename = typename enable_if<  // issue #1897
@@ -43,9 +96,8 @@ DeserializationError deserialize(JsonDocument& doc, TStream&& input,
   auto pool = VariantAttorney::getPool(doc);
   auto options = makeDeserializationOptions(args...);
   doc.clear();
-  return makeDeserializer<TDeserializer>(pool, reader,
-                                         makeStringStorage(input, pool))
-      .parse(*data, options.filter, options.nestingLimit);
+  return parseWithOptions<TDeserializer>(
+      pool, reader, makeStringStorage(input, pool), *data, options);
 }
 
 template <template <typename, typename> class TDeserializer, typename TChar,
@@ -58,9 +110,43 @@ DeserializationError deserialize(JsonDocument& doc, TChar* input,
   auto pool = VariantAttorney::getPool(doc);
   auto options = makeDeserializationOptions(args...);
   doc.clear();
-  return makeDeserializer<TDeserializer>(pool, reader,
-                                         makeStringStorage(input, pool))
-      .parse(*data, options.filter, options.nestingLimit);
+  return parseWithOptions<TDeserializer>(
+      pool, reader, makeStringStorage(input, pool), *data, options);
+}
+
+// Parses into a variant of an existing document, using the document's pool.
+// The document isn't cleared, and objects are merged with the existing ones.
+template <template <typename, typename> class TDeserializer, typename TVariant,
+          typename TStream, typename... Args,
+          typename = typename enable_if<
+              IsVariant<TVariant>::value &&
+              !is_integral<typename first_or_void<Args...>::type>::value>::type>
+DeserializationError deserialize(const TVariant& dst, TStream&& input,
+                                 Args... args) {
+  auto reader = makeReader(detail::forward<TStream>(input));
+  auto data = VariantAttorney::getOrCreateData(dst);
+  auto pool = VariantAttorney::getPool(dst);
+  if (!data)
+    return DeserializationError::NoMemory;
+  auto options = makeDeserializationOptions(args...);
+  return parseWithOptions<TDeserializer>(
+      pool, reader, makeStringStorage(input, pool), *data, options);
+}
+
+template <template <typename, typename> class TDeserializer, typename TVariant,
+          typename TChar, typename Size, typename... Args,
+          typename = typename enable_if<IsVariant<TVariant>::value &&
+                                        is_integral<Size>::value>::type>
+DeserializationError deserialize(const TVariant& dst, TChar* input,
+                                 Size inputSize, Args... args) {
+  auto reader = makeReader(input, size_t(inputSize));
+  auto data = VariantAttorney::getOrCreateData(dst);
+  auto pool = VariantAttorney::getPool(dst);
+  if (!data)
+    return DeserializationError::NoMemory;
+  auto options = makeDeserializationOptions(args...);
+  return parseWithOptions<TDeserializer>(
+      pool, reader, makeStringStorage(input, pool), *data, options);
 }
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
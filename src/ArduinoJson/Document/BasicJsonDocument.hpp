@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/Memory/PoolCompactor.hpp>
 
 ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
 
@@ -49,6 +50,7 @@ class BasicJsonDocument : AllocatorOwner<TAllocator>, public JsonDocument {
   BasicJsonDocument(const BasicJsonDocument& src)
       : AllocatorOwner<TAllocator>(src), JsonDocument() {
     copyAssignFrom(src);
+    pool_.setGrowable(src.pool_.growable());
   }
 
   // Move-constructor
@@ -103,9 +105,27 @@ class BasicJsonDocument : AllocatorOwner<TAllocator>, public JsonDocument {
     return *this;
   }
 
+  // Allows the memory pool to grow, by chaining blocks from the allocator,
+  // when the capacity is exhausted. The blocks are as large as the initial
+  // capacity, or as the value that didn't fit.
+  // Since the slots are linked by relative offsets, the allocator must return
+  // blocks within the range of ARDUINOJSON_SLOT_OFFSET_SIZE; the allocation
+  // fails otherwise, as if the pool couldn't grow.
+  void setGrowable(bool growable) {
+    pool_.setGrowable(growable);
+  }
+
+  bool growable() const {
+    return pool_.growable();
+  }
+
   // Reduces the capacity of the memory pool to match the current usage.
   // https://arduinojson.org/v6/api/basicjsondocument/shrinktofit/
   void shrinkToFit() {
+    // gather the blocks of a growable pool
+    if (pool_.hasAdditionalBlocks() && !garbageCollect())
+      return;
+
     ptrdiff_t bytes_reclaimed = pool_.squash();
     if (bytes_reclaimed == 0)
       return;
@@ -121,8 +141,23 @@ class BasicJsonDocument : AllocatorOwner<TAllocator>, public JsonDocument {
   }
 
   // Reclaims the memory leaked when removing and replacing values.
+  // Compacts the pool in place; the marks (about an eighth of the strings) go
+  // in its free space or, if it's too small, in a temporary allocation.
+  // A pool with additional blocks is copied into a single block instead.
   // https://arduinojson.org/v6/api/jsondocument/garbagecollect/
   bool garbageCollect() {
+    if (!pool_.hasAdditionalBlocks()) {
+      detail::PoolCompactor compactor(&pool_);
+      if (compactor.compactInFreeZone(&data_))
+        return true;
+      void* scratch = this->allocate(compactor.scratchSize());
+      if (!scratch)
+        return false;
+      compactor.compact(&data_, scratch);
+      this->deallocate(scratch);
+      return true;
+    }
+
     // make a temporary clone and move assign
     BasicJsonDocument tmp(*this);
     if (!tmp.capacity())
@@ -136,21 +171,42 @@ class BasicJsonDocument : AllocatorOwner<TAllocator>, public JsonDocument {
  private:
   detail::MemoryPool allocPool(size_t requiredSize) {
     size_t capa = detail::addPadding(requiredSize);
-    return {reinterpret_cast<char*>(this->allocate(capa)), capa};
+    detail::MemoryPool pool(reinterpret_cast<char*>(this->allocate(capa)),
+                            capa);
+    pool.setBlockAllocator(blockAllocator());
+    return pool;
   }
 
   void reallocPool(size_t requiredSize) {
     size_t capa = detail::addPadding(requiredSize);
-    if (capa == pool_.capacity())
+    if (capa == pool_.capacity() && !pool_.hasAdditionalBlocks())
       return;
+    bool growable = pool_.growable();
     freePool();
     replacePool(allocPool(detail::addPadding(requiredSize)));
+    pool_.setGrowable(growable);
   }
 
   void freePool() {
+    pool_.clear();  // releases the additional blocks
     this->deallocate(getPool()->buffer());
   }
 
+  detail::BlockAllocator blockAllocator() {
+    detail::BlockAllocator blocks = {
+        allocateBlock, deallocateBlock,
+        static_cast<AllocatorOwner<TAllocator>*>(this)};
+    return blocks;
+  }
+
+  static void* allocateBlock(void* owner, size_t size) {
+    return static_cast<AllocatorOwner<TAllocator>*>(owner)->allocate(size);
+  }
+
+  static void deallocateBlock(void* owner, void* ptr) {
+    static_cast<AllocatorOwner<TAllocator>*>(owner)->deallocate(ptr);
+  }
+
   void copyAssignFrom(const JsonDocument& src) {
     reallocPool(src.capacity());
     set(src);
@@ -160,6 +216,7 @@ class BasicJsonDocument : AllocatorOwner<TAllocator>, public JsonDocument {
     freePool();
     data_ = src.data_;
     pool_ = src.pool_;
+    pool_.setBlockAllocator(blockAllocator());  // src's points to src
     src.data_.setNull();
     src.pool_ = {0, 0};
   }
@@ -243,29 +243,29 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
   }
 
   // Removes an element of the root array.
-  // ⚠️ Doesn't release the memory associated with the removed element.
+  // The pool reuses the memory of the removed element.
   // https://arduinojson.org/v6/api/jsondocument/remove/
   FORCE_INLINE void remove(size_t index) {
-    data_.remove(index);
+    data_.remove(index, &pool_);
   }
 
   // Removes a member of the root object.
-  // ⚠️ Doesn't release the memory associated with the removed element.
+  // The pool reuses the memory of the removed element.
   // https://arduinojson.org/v6/api/jsondocument/remove/
   template <typename TChar>
   FORCE_INLINE typename detail::enable_if<detail::IsString<TChar*>::value>::type
   remove(TChar* key) {
-    data_.remove(detail::adaptString(key));
+    data_.remove(detail::adaptString(key), &pool_);
   }
 
   // Removes a member of the root object.
-  // ⚠️ Doesn't release the memory associated with the removed element.
+  // The pool reuses the memory of the removed element.
   // https://arduinojson.org/v6/api/jsondocument/remove/
   template <typename TString>
   FORCE_INLINE
       typename detail::enable_if<detail::IsString<TString>::value>::type
       remove(const TString& key) {
-    data_.remove(detail::adaptString(key));
+    data_.remove(detail::adaptString(key), &pool_);
   }
 
   FORCE_INLINE operator JsonVariant() {
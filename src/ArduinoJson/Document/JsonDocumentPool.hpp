@@ -0,0 +1,219 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/DynamicJsonDocument.hpp>
+
+#if ARDUINOJSON_ENABLE_STD_MUTEX
+#  include <mutex>
+#endif
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+template <typename TMutex>
+class LockGuard {
+ public:
+  LockGuard(TMutex& mutex) : mutex_(mutex) {
+    mutex_.lock();
+  }
+
+  ~LockGuard() {
+    mutex_.unlock();
+  }
+
+ private:
+  LockGuard(const LockGuard&);
+  LockGuard& operator=(const LockGuard&);
+
+  TMutex& mutex_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Keeps released documents for reuse, so that a program that handles many
+// requests doesn't allocate and free a memory pool for each one.
+// The capacities are sorted in classes: minCapacity, 2 * minCapacity,
+// 4 * minCapacity, and so on. Each class has its own list of idle documents,
+// protected by TMutex (anything with lock() and unlock()). The lock is only
+// held to pop or push a document; allocations happen outside of it.
+template <typename TAllocator, typename TMutex>
+class BasicJsonDocumentPool {
+ public:
+  typedef BasicJsonDocument<TAllocator> Document;
+
+  static const size_t classCount = 16;
+
+  BasicJsonDocumentPool(size_t minCapacity, TAllocator alloc = TAllocator())
+      : minCapacity_(detail::addPadding(minCapacity > 0 ? minCapacity : 1)),
+        allocator_(alloc) {
+    for (size_t i = 0; i < classCount; i++) {
+      classes_[i].idle = 0;
+      classes_[i].idleCount = 0;
+      classes_[i].inUse = 0;
+      classes_[i].highWaterMark = 0;
+    }
+  }
+
+  // All the documents must be released before.
+  ~BasicJsonDocumentPool() {
+    for (size_t i = 0; i < classCount; i++) {
+      ARDUINOJSON_ASSERT(classes_[i].inUse == 0);
+      deleteList(classes_[i].idle);
+    }
+  }
+
+  // Returns an empty document whose capacity is at least the specified one.
+  // Returns null if the capacity exceeds the largest class or the allocation
+  // fails.
+  Document* acquire(size_t capacity) {
+    size_t index = classOf(capacity);
+    if (index >= classCount)
+      return 0;
+    SizeClass& sizeClass = classes_[index];
+    {
+      detail::LockGuard<TMutex> lock(mutex_);
+      sizeClass.inUse++;
+      if (sizeClass.inUse > sizeClass.highWaterMark)
+        sizeClass.highWaterMark = sizeClass.inUse;
+      Node* node = sizeClass.idle;
+      if (node) {
+        sizeClass.idle = node->next;
+        sizeClass.idleCount--;
+        return node;
+      }
+    }
+    Node* node = new Node(capacityOf(index), allocator_, index);
+    if (node->capacity() == capacityOf(index))
+      return node;
+    delete node;
+    detail::LockGuard<TMutex> lock(mutex_);
+    sizeClass.inUse--;
+    return 0;
+  }
+
+  // Clears the document and keeps it for the next acquire().
+  // The document must come from acquire().
+  void release(Document* doc) {
+    if (!doc)
+      return;
+    Node* node = static_cast<Node*>(doc);
+    SizeClass& sizeClass = classes_[node->index];
+    node->clear();
+    node->setGrowable(false);
+    bool keep = node->capacity() == capacityOf(node->index);  // shrinkToFit()
+    if (!keep)
+      delete node;
+    detail::LockGuard<TMutex> lock(mutex_);
+    sizeClass.inUse--;
+    if (keep) {
+      node->next = sizeClass.idle;
+      sizeClass.idle = node;
+      sizeClass.idleCount++;
+    }
+  }
+
+  // Frees the idle documents that exceed the high-water mark, i.e., the
+  // largest number of documents in use since the previous call, then starts
+  // a new period.
+  void trim() {
+    for (size_t i = 0; i < classCount; i++) {
+      Node* surplus;
+      {
+        detail::LockGuard<TMutex> lock(mutex_);
+        SizeClass& sizeClass = classes_[i];
+        size_t keep = sizeClass.highWaterMark - sizeClass.inUse;
+        surplus = detachIdleDocuments(sizeClass, keep);
+        sizeClass.highWaterMark = sizeClass.inUse;
+      }
+      deleteList(surplus);
+    }
+  }
+
+  // Returns the number of documents waiting for reuse
+  size_t idleCount() const {
+    detail::LockGuard<TMutex> lock(mutex_);
+    size_t total = 0;
+    for (size_t i = 0; i < classCount; i++)
+      total += classes_[i].idleCount;
+    return total;
+  }
+
+  // Returns the number of documents that trim() keeps, i.e., for each class,
+  // the largest number in use at the same time since the last trim()
+  size_t highWaterMark() const {
+    detail::LockGuard<TMutex> lock(mutex_);
+    size_t total = 0;
+    for (size_t i = 0; i < classCount; i++)
+      total += classes_[i].highWaterMark;
+    return total;
+  }
+
+ private:
+  BasicJsonDocumentPool(const BasicJsonDocumentPool&);
+  BasicJsonDocumentPool& operator=(const BasicJsonDocumentPool&);
+
+  struct Node : Document {
+    Node(size_t capa, TAllocator alloc, size_t i)
+        : Document(capa, alloc), next(0), index(i) {}
+
+    Node* next;
+    size_t index;
+  };
+
+  struct SizeClass {
+    Node* idle;
+    size_t idleCount;
+    size_t inUse;
+    size_t highWaterMark;
+  };
+
+  size_t capacityOf(size_t index) const {
+    return minCapacity_ << index;
+  }
+
+  size_t classOf(size_t capacity) const {
+    size_t index = 0;
+    while (index < classCount && capacityOf(index) < capacity)
+      index++;
+    return index;
+  }
+
+  // Unlinks the idle documents beyond the first n
+  static Node* detachIdleDocuments(SizeClass& sizeClass, size_t n) {
+    if (sizeClass.idleCount <= n)
+      return 0;
+    Node** link = &sizeClass.idle;
+    for (size_t i = 0; i < n; i++)
+      link = &(*link)->next;
+    Node* surplus = *link;
+    *link = 0;
+    sizeClass.idleCount = n;
+    return surplus;
+  }
+
+  static void deleteList(Node* node) {
+    while (node) {
+      Node* next = node->next;
+      delete node;
+      node = next;
+    }
+  }
+
+  size_t minCapacity_;
+  TAllocator allocator_;
+  mutable TMutex mutex_;
+  SizeClass classes_[classCount];
+};
+
+// libstdc++ declares std::mutex only when it's built with thread support
+#if ARDUINOJSON_ENABLE_STD_MUTEX && \
+    (!defined(__GLIBCXX__) || defined(_GLIBCXX_HAS_GTHREADS))
+// A pool of DynamicJsonDocument that can be shared between threads
+typedef BasicJsonDocumentPool<DefaultAllocator, std::mutex> JsonDocumentPool;
+#endif
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,227 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/DeserializationError.hpp>
+#include <ArduinoJson/Deserialization/Reader.hpp>
+#include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/Polyfills/utility.hpp>
+#include <ArduinoJson/Serialization/CountingDecorator.hpp>
+#include <ArduinoJson/Serialization/Writer.hpp>
+#include <ArduinoJson/Serialization/Writers/DummyWriter.hpp>
+
+#include <stddef.h>  // offsetof
+#include <stdint.h>  // uint64_t, uintptr_t
+#include <string.h>  // memcmp
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A snapshot is this header, followed by the root variant, the strings, and
+// the variants of the memory pool, copied as they are in memory.
+// Only a program with the same byte order, pointer size, and configuration
+// can load it; the header records them so loadSnapshot() rejects the others.
+struct SnapshotHeader {
+  char magic[4];
+  uint8_t version;
+  uint8_t byteOrder;  // 'L' or 'B'
+  uint8_t pointerSize;
+  uint8_t slotSize;
+  uint8_t floatSize;
+  uint8_t integerSize;
+  uint8_t slotOffsetSize;  // ARDUINOJSON_SLOT_OFFSET_SIZE
+  uint8_t slotFlags;       // see makeSnapshotSlotFlags()
+  uint8_t reserved[4];
+  uint64_t stringsAddress;  // the pointers are relative to these addresses
+  uint64_t variantsAddress;
+  uint64_t stringsSize;
+  uint64_t variantsSize;
+};
+
+// The settings that change the layout of the slots without always changing
+// their size
+inline uint8_t makeSnapshotSlotFlags() {
+  return uint8_t(ARDUINOJSON_STORE_KEY_SIZE |
+                 ARDUINOJSON_COMPACT_SLOTS << 1 |
+                 ARDUINOJSON_INLINE_SHORT_STRINGS << 2 |
+                 ARDUINOJSON_STORE_COLLECTION_SIZE << 3);
+}
+
+inline SnapshotHeader makeSnapshotHeader() {
+  SnapshotHeader header = {{'A', 'J', 'S', 'N'},
+                           2,
+                           ARDUINOJSON_LITTLE_ENDIAN ? 'L' : 'B',
+                           sizeof(void*),
+                           sizeof(VariantSlot),
+                           sizeof(JsonFloat),
+                           sizeof(JsonInteger),
+                           ARDUINOJSON_SLOT_OFFSET_SIZE,
+                           makeSnapshotSlotFlags(),
+                           {0, 0, 0, 0},
+                           0,
+                           0,
+                           0,
+                           0};
+  return header;
+}
+
+inline bool isCompatible(const SnapshotHeader& header) {
+  SnapshotHeader expected = makeSnapshotHeader();
+  return memcmp(&header, &expected, offsetof(SnapshotHeader, reserved)) == 0;
+}
+
+// Returns true if the keys and strings are in the pool, so that
+// movePointers() can relocate them
+inline bool isRelocatable(const VariantData* variant) {
+  switch (variant->type()) {
+    case VALUE_IS_LINKED_RAW:
+    case VALUE_IS_LINKED_STRING:
+    case VALUE_IS_LINKED_LAZY:
+    case VALUE_IS_UNTERMINATED_STRING:
+    case VALUE_IS_LINKED_BINARY:
+    case VALUE_IS_LINKED_EXT:
+      return false;
+  }
+  const CollectionData* collection = variant->asCollection();
+  if (!collection)
+    return true;
+  bool isObject = variant->isObject();
+  for (const VariantSlot* slot = collection->head(); slot;
+       slot = slot->next()) {
+    if (isObject && !slot->ownsKey())
+      return false;
+    if (!isRelocatable(slot->data()))
+      return false;
+  }
+  return true;
+}
+
+template <typename TWriter>
+size_t writeSnapshot(const JsonDocument& doc, TWriter writer) {
+  const VariantData* data = VariantAttorney::getData(doc);
+  // the pool isn't modified
+  MemoryPool* pool = VariantAttorney::getPool(const_cast<JsonDocument&>(doc));
+
+  if (!isRelocatable(data) || pool->hasAdditionalBlocks())
+    return 0;
+
+  SnapshotHeader header = makeSnapshotHeader();
+  header.stringsAddress = uintptr_t(pool->buffer());
+  header.variantsAddress = uintptr_t(pool->variants());
+  header.stringsSize = pool->stringsSize();
+  header.variantsSize = pool->variantsSize();
+
+  CountingDecorator<TWriter> output(writer);
+  output.write(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+  output.write(reinterpret_cast<const uint8_t*>(data), sizeof(VariantData));
+  output.write(reinterpret_cast<const uint8_t*>(pool->buffer()),
+               pool->stringsSize());
+  output.write(reinterpret_cast<const uint8_t*>(pool->variants()),
+               pool->variantsSize());
+
+  // a truncated snapshot is useless
+  size_t expectedSize = sizeof(header) + sizeof(VariantData) + pool->size();
+  return output.count() == expectedSize ? expectedSize : 0;
+}
+
+template <typename TReader>
+DeserializationError::Code readBytes(TReader& reader, void* p, size_t n) {
+  if (reader.readBytes(reinterpret_cast<char*>(p), n) != n)
+    return DeserializationError::IncompleteInput;
+  return DeserializationError::Ok;
+}
+
+template <typename TReader>
+DeserializationError::Code readSnapshot(JsonDocument& doc, TReader reader) {
+  DeserializationError::Code err;
+  MemoryPool* pool = VariantAttorney::getPool(doc);
+  VariantData* data = VariantAttorney::getData(doc);
+  doc.clear();
+
+  SnapshotHeader header;
+  size_t n = reader.readBytes(reinterpret_cast<char*>(&header), sizeof(header));
+  if (n == 0)
+    return DeserializationError::EmptyInput;
+  if (n < sizeof(header))
+    return DeserializationError::IncompleteInput;
+  if (!isCompatible(header) || header.variantsSize % sizeof(VariantSlot))
+    return DeserializationError::InvalidInput;
+
+  VariantData root;
+  err = readBytes(reader, &root, sizeof(root));
+  if (err)
+    return err;
+
+  if (header.stringsSize > pool->capacity() ||
+      header.variantsSize > pool->capacity() ||
+      !pool->allocZones(size_t(header.stringsSize),
+                        size_t(header.variantsSize)))
+    return DeserializationError::NoMemory;
+
+  err = readBytes(reader, pool->buffer(), pool->stringsSize());
+  if (!err)
+    err = readBytes(reader, pool->variants(), pool->variantsSize());
+  if (err) {
+    pool->clear();
+    return err;
+  }
+
+  // same as BasicJsonDocument::shrinkToFit()
+  root.movePointers(
+      ptrdiff_t(uintptr_t(pool->buffer()) - uintptr_t(header.stringsAddress)),
+      ptrdiff_t(uintptr_t(pool->variants()) -
+                uintptr_t(header.variantsAddress)));
+  *data = root;
+  return DeserializationError::Ok;
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Writes an image of the document that loadSnapshot() loads without parsing.
+// Returns 0 if the document has linked strings (i.e., stored by pointer),
+// since they are outside of the memory pool, or if the pool grew beyond its
+// first block (call shrinkToFit() to gather the blocks).
+template <typename TDestination>
+size_t saveSnapshot(const JsonDocument& doc, TDestination& output) {
+  using namespace detail;
+  return writeSnapshot(doc, Writer<TDestination>(output));
+}
+
+// Writes an image of the document that loadSnapshot() loads without parsing.
+// Returns 0 if the document has linked strings, or if the buffer is too small.
+inline size_t saveSnapshot(const JsonDocument& doc, void* output,
+                           size_t size) {
+  using namespace detail;
+  return writeSnapshot(
+      doc, StaticStringWriter(reinterpret_cast<char*>(output), size));
+}
+
+// Computes the size of the snapshot that saveSnapshot() produces.
+inline size_t measureSnapshot(const JsonDocument& doc) {
+  using namespace detail;
+  return writeSnapshot(doc, DummyWriter());
+}
+
+// Loads a snapshot produced by saveSnapshot() on the same platform.
+// The document needs at least the memoryUsage() of the saved one.
+// The snapshot must come from a trusted source: only the header is checked.
+template <typename TInput>
+DeserializationError loadSnapshot(JsonDocument& doc, TInput&& input) {
+  using namespace detail;
+  return readSnapshot(doc, makeReader(detail::forward<TInput>(input)));
+}
+
+// Loads a snapshot produced by saveSnapshot() on the same platform.
+// The document needs at least the memoryUsage() of the saved one.
+// The snapshot must come from a trusted source: only the header is checked.
+template <typename TChar>
+DeserializationError loadSnapshot(JsonDocument& doc, TChar* input,
+                                  size_t size) {
+  using namespace detail;
+  return readSnapshot(doc, makeReader(input, size));
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
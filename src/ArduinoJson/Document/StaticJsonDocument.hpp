@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/Memory/PoolCompactor.hpp>
 
 ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
 
@@ -48,8 +49,13 @@ class StaticJsonDocument : public JsonDocument {
   }
 
   // Reclaims the memory leaked when removing and replacing values.
+  // Compacts the pool in place if its free space can hold the marks (about
+  // an eighth of the strings), otherwise makes a copy on the stack.
   // https://arduinojson.org/v6/api/jsondocument/garbagecollect/
   void garbageCollect() {
+    detail::PoolCompactor compactor(&pool_);
+    if (compactor.compactInFreeZone(&data_))
+      return;
     StaticJsonDocument tmp(*this);
     set(tmp);
   }
@@ -12,6 +12,7 @@
 #include <ArduinoJson/Memory/MemoryPool.hpp>
 #include <ArduinoJson/Numbers/parseNumber.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/limits.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
 #include <ArduinoJson/Polyfills/utility.hpp>
 #include <ArduinoJson/Variant/VariantData.hpp>
@@ -25,6 +26,7 @@ class JsonDeserializer {
                    TStringStorage stringStorage)
       : stringStorage_(stringStorage),
         foundSomething_(false),
+        capturing_(false),
         latch_(reader),
         pool_(pool) {}
 
@@ -43,12 +45,42 @@ class JsonDeserializer {
     return err;
   }
 
+  // see KeyDictionary
+  void setKeyDictionary(KeyDictionary keys) {
+    keys_ = keys;
+  }
+
+  // Descends along the path and parses only the targeted values.
+  // Stops reading as soon as the path reports that all targets are complete,
+  // so trailing characters are not checked.
+  template <typename TPath>
+  DeserializationError extract(
+      TPath path, DeserializationOption::NestingLimit nestingLimit) {
+    return extractVariant(path, nestingLimit);
+  }
+
+  // Writes the value to a serializer that needs the number of elements before
+  // the elements themselves, like MsgPackSerializer.
+  // The strings go through the string storage but are never saved, so the
+  // pool only needs to hold the longest one.
+  // Each array or object is scanned ahead to count its elements; this
+  // requires an input in memory, and nested values are scanned once per
+  // level. Trailing characters are not checked.
+  template <typename TSerializer>
+  DeserializationError transcode(
+      TSerializer& serializer,
+      DeserializationOption::NestingLimit nestingLimit) {
+    return transcodeVariant(serializer, nestingLimit);
+  }
+
  private:
   char current() {
     return latch_.current();
   }
 
   void move() {
+    if (capturing_)
+      stringStorage_.append(latch_.current());
     latch_.clear();
   }
 
@@ -69,25 +101,35 @@ class JsonDeserializer {
     if (err)
       return err;
 
+    if (filter.captured())
+      return parseRawValue(variant, nestingLimit);
+
     switch (current()) {
       case '[':
-        if (filter.allowArray())
+        if (filter.deferred())
+          return parseLazyValue(variant, nestingLimit);
+        else if (filter.allowArray())
           return parseArray(variant.toArray(), filter, nestingLimit);
         else
-          return skipArray(nestingLimit);
+          return skipRejectedVariant(nestingLimit);
 
       case '{':
-        if (filter.allowObject())
-          return parseObject(variant.toObject(), filter, nestingLimit);
+        // when the variant is already an object, the members are merged
+        if (filter.deferred())
+          return parseLazyValue(variant, nestingLimit);
+        else if (filter.allowObject())
+          return parseObject(
+              variant.isObject() ? *variant.asObject() : variant.toObject(),
+              filter, nestingLimit);
         else
-          return skipObject(nestingLimit);
+          return skipRejectedVariant(nestingLimit);
 
       case '\"':
       case '\'':
         if (filter.allowValue())
           return parseStringValue(variant);
         else
-          return skipQuotedString();
+          return skipRejectedVariant(nestingLimit);
 
       case 't':
         if (filter.allowValue())
@@ -100,18 +142,32 @@ class JsonDeserializer {
         return skipKeyword("false");
 
       case 'n':
-        // the variant should already by null, except if the same object key was
-        // used twice, as in {"a":1,"a":null}
+        // the variant is usually null already, except if the same object key
+        // was used twice, as in {"a":1,"a":null}, or when merging
+        if (filter.allowValue())
+          variant.setNull();
         return skipKeyword("null");
 
       default:
         if (filter.allowValue())
           return parseNumericValue(variant);
         else
-          return skipNumericValue();
+          return skipRejectedVariant(nestingLimit);
     }
   }
 
+  // Skips a value that the filter rejected
+  DeserializationError::Code skipRejectedVariant(
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // the first character is already in the latch
+    SkipCounter<TStringStorage> counter(stringStorage_, true, 1);
+    return skipVariant(nestingLimit);
+  }
+
   DeserializationError::Code skipVariant(
       DeserializationOption::NestingLimit nestingLimit) {
     DeserializationError::Code err;
@@ -182,7 +238,7 @@ class JsonDeserializer {
         if (err)
           return err;
       } else {
-        err = skipVariant(nestingLimit.decrement());
+        err = skipRejectedVariant(nestingLimit.decrement());
         if (err)
           return err;
       }
@@ -276,16 +332,19 @@ class JsonDeserializer {
       if (memberFilter.allow()) {
         VariantData* variant = object.getMember(adaptString(key.c_str()));
         if (!variant) {
-          // Save key in memory pool.
+          // Save key in memory pool, unless it's in the dictionary.
           // This MUST be done before adding the slot.
-          key = stringStorage_.save();
+          key = saveKey();
 
           // Allocate slot in object
           VariantSlot* slot = object.addSlot(pool_);
           if (!slot)
             return DeserializationError::NoMemory;
 
-          slot->setKey(key);
+          if (!slot->setKey(key, pool_)) {
+            object.removeSlot(slot, pool_);
+            return DeserializationError::NoMemory;
+          }
 
           variant = slot->data();
         }
@@ -295,7 +354,7 @@ class JsonDeserializer {
         if (err)
           return err;
       } else {
-        err = skipVariant(nestingLimit.decrement());
+        err = skipRejectedVariant(nestingLimit.decrement());
         if (err)
           return err;
       }
@@ -376,7 +435,415 @@ class JsonDeserializer {
     }
   }
 
+  // Copies the next value verbatim to the string storage
+  DeserializationError::Code captureVariant(
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    stringStorage_.startString();
+
+    // every character consumed by skipVariant() goes to the string storage
+    capturing_ = true;
+    err = skipVariant(nestingLimit);
+    capturing_ = false;
+    if (err)
+      return err;
+
+    if (!stringStorage_.isValid())
+      return DeserializationError::NoMemory;
+
+    return DeserializationError::Ok;
+  }
+
+  // Stores the array or object verbatim (see DeserializationOption::Lazy)
+  DeserializationError::Code parseLazyValue(
+      VariantData& variant, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err = captureVariant(nestingLimit);
+    if (err)
+      return err;
+
+    variant.setLazy(stringStorage_.save());
+
+    return DeserializationError::Ok;
+  }
+
+  // Stores the value verbatim (see DeserializationOption::CaptureRaw)
+  DeserializationError::Code parseRawValue(
+      VariantData& variant, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err = captureVariant(nestingLimit);
+    if (err)
+      return err;
+
+    variant.setRaw(stringStorage_.save());
+
+    return DeserializationError::Ok;
+  }
+
+  template <typename TPath>
+  DeserializationError::Code extractVariant(
+      TPath path, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    VariantData* target = path.target();
+    if (target) {
+      err = parseVariant(*target, AllowAllFilter(), nestingLimit);
+      if (err)
+        return err;
+      path.commit();
+      return DeserializationError::Ok;
+    }
+
+    switch (current()) {
+      case '[':
+        return extractArray(path, nestingLimit);
+
+      case '{':
+        return extractObject(path, nestingLimit);
+
+      default:
+        return skipVariant(nestingLimit);
+    }
+  }
+
+  template <typename TPath>
+  DeserializationError::Code extractArray(
+      TPath path, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening braket
+    ARDUINOJSON_ASSERT(current() == '[');
+    move();
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty array?
+    if (eat(']'))
+      return DeserializationError::Ok;
+
+    // Read each value
+    for (size_t index = 0;; index++) {
+      // 1 - Extract or skip value
+      TPath elementPath = path[index];
+      if (elementPath.allow())
+        err = extractVariant(elementPath, nestingLimit.decrement());
+      else
+        err = skipVariant(nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // 2 - Stop if all targets are complete
+      if (path.done())
+        return DeserializationError::Ok;
+
+      // 3 - Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // 4 - More values?
+      if (eat(']'))
+        return DeserializationError::Ok;
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+  template <typename TPath>
+  DeserializationError::Code extractObject(
+      TPath path, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening brace
+    ARDUINOJSON_ASSERT(current() == '{');
+    move();
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty object?
+    if (eat('}'))
+      return DeserializationError::Ok;
+
+    // Read each key value pair
+    for (;;) {
+      // Parse key
+      err = parseKey();
+      if (err)
+        return err;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // Colon
+      if (!eat(':'))
+        return DeserializationError::InvalidInput;
+
+      // Extract or skip value
+      TPath memberPath = path[stringStorage_.str().c_str()];
+      if (memberPath.allow())
+        err = extractVariant(memberPath, nestingLimit.decrement());
+      else
+        err = skipVariant(nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // Stop if all targets are complete
+      if (path.done())
+        return DeserializationError::Ok;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // More keys/values?
+      if (eat('}'))
+        return DeserializationError::Ok;
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+    }
+  }
+
+  template <typename TSerializer>
+  DeserializationError::Code transcodeVariant(
+      TSerializer& serializer,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    switch (current()) {
+      case '[':
+        return transcodeArray(serializer, nestingLimit);
+
+      case '{':
+        return transcodeObject(serializer, nestingLimit);
+
+      case '\"':
+      case '\'': {
+        stringStorage_.startString();
+        err = parseQuotedString();
+        if (err)
+          return err;
+        JsonString value = stringStorage_.str();
+        serializer.visitString(value.c_str(), value.size());
+        return DeserializationError::Ok;
+      }
+
+      default: {
+        // booleans, null and numbers don't use the pool
+        VariantData value;
+        err = parseVariant(value, AllowAllFilter(), nestingLimit);
+        if (err)
+          return err;
+        value.accept(serializer);
+        return DeserializationError::Ok;
+      }
+    }
+  }
+
+  template <typename TSerializer>
+  DeserializationError::Code transcodeArray(
+      TSerializer& serializer,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    size_t count;
+    err = countElements(count, nestingLimit);
+    if (err)
+      return err;
+    serializer.writeArrayHeader(count);
+
+    // Skip opening braket
+    ARDUINOJSON_ASSERT(current() == '[');
+    move();
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty array?
+    if (eat(']'))
+      return DeserializationError::Ok;
+
+    // Read each value
+    for (;;) {
+      // 1 - Transcode value
+      err = transcodeVariant(serializer, nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // 2 - Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // 3 - More values?
+      if (eat(']'))
+        return DeserializationError::Ok;
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+  template <typename TSerializer>
+  DeserializationError::Code transcodeObject(
+      TSerializer& serializer,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    size_t count;
+    err = countElements(count, nestingLimit);
+    if (err)
+      return err;
+    serializer.writeMapHeader(count);
+
+    // Skip opening brace
+    ARDUINOJSON_ASSERT(current() == '{');
+    move();
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty object?
+    if (eat('}'))
+      return DeserializationError::Ok;
+
+    // Read each key value pair
+    for (;;) {
+      // Parse key
+      err = parseKey();
+      if (err)
+        return err;
+      JsonString key = stringStorage_.str();
+      serializer.writeKey(key.c_str(), key.size());
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // Colon
+      if (!eat(':'))
+        return DeserializationError::InvalidInput;
+
+      // Transcode value
+      err = transcodeVariant(serializer, nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // More keys/values?
+      if (eat('}'))
+        return DeserializationError::Ok;
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+    }
+  }
+
+  // Counts the elements of the array or object that starts at the current
+  // character, by skipping them with a copy of the deserializer.
+  // The nested containers are scanned again when they're transcoded, so the
+  // total cost is O(depth * n); buffering the counts would require memory
+  // proportional to the number of containers.
+  DeserializationError::Code countElements(
+      size_t& count, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+    JsonDeserializer scanner(*this);
+    scanner.capturing_ = false;
+
+    bool isObject = scanner.current() == '{';
+    char closing = isObject ? '}' : ']';
+    scanner.move();
+
+    count = 0;
+
+    err = scanner.skipSpacesAndComments();
+    if (err)
+      return err;
+
+    if (scanner.eat(closing))
+      return DeserializationError::Ok;
+
+    for (;;) {
+      if (isObject) {
+        err = scanner.skipKey();
+        if (err)
+          return err;
+
+        err = scanner.skipSpacesAndComments();
+        if (err)
+          return err;
+
+        if (!scanner.eat(':'))
+          return DeserializationError::InvalidInput;
+      }
+
+      err = scanner.skipVariant(nestingLimit.decrement());
+      if (err)
+        return err;
+      count++;
+
+      err = scanner.skipSpacesAndComments();
+      if (err)
+        return err;
+
+      if (scanner.eat(closing))
+        return DeserializationError::Ok;
+      if (!scanner.eat(','))
+        return DeserializationError::InvalidInput;
+
+      err = scanner.skipSpacesAndComments();
+      if (err)
+        return err;
+    }
+  }
+
   DeserializationError::Code parseKey() {
+    StatsTimer<TStringStorage> timer(stringStorage_,
+                                     &DeserializationStats::stringTime);
     stringStorage_.startString();
     if (isQuote(current())) {
       return parseQuotedString();
@@ -387,6 +854,8 @@ class JsonDeserializer {
 
   DeserializationError::Code parseStringValue(VariantData& variant) {
     DeserializationError::Code err;
+    StatsTimer<TStringStorage> timer(stringStorage_,
+                                     &DeserializationStats::stringTime);
 
     stringStorage_.startString();
 
@@ -394,7 +863,7 @@ class JsonDeserializer {
     if (err)
       return err;
 
-    variant.setString(stringStorage_.save());
+    variant.setString(stringStorage_);
 
     return DeserializationError::Ok;
   }
@@ -511,6 +980,8 @@ class JsonDeserializer {
   }
 
   DeserializationError::Code parseNumericValue(VariantData& result) {
+    StatsTimer<TStringStorage> timer(stringStorage_,
+                                     &DeserializationStats::numberTime);
     uint8_t n = 0;
 
     char c = current();
@@ -659,15 +1130,58 @@ class JsonDeserializer {
     return DeserializationError::Ok;
   }
 
+  // Links the key to the dictionary if it's there, saves it otherwise
+  JsonString saveKey() {
+    JsonString key = stringStorage_.str();
+    const char* linked = keys_.find(key.c_str(), key.size());
+    if (linked)
+      return JsonString(linked, JsonString::Linked);
+    return stringStorage_.save();
+  }
+
   TStringStorage stringStorage_;
   bool foundSomething_;
+  bool capturing_;
   Latch<TReader> latch_;
   MemoryPool* pool_;
+  KeyDictionary keys_;
   char buffer_[64];  // using a member instead of a local variable because it
                      // ended in the recursive path after compiler inlined the
                      // code
 };
 
+// Errors are not reported: the value becomes null if the text can't be parsed,
+// and the pool is marked as overflowed if it's full.
+// The caller's nesting limit was enforced when the text was captured (see
+// parseLazyValue()), so the text is parsed without further limit.
+inline VariantData* variantResolve(VariantData* var, MemoryPool* pool) {
+  if (!var || !pool || !var->isLazy())
+    return var;
+
+  DeserializationOption::NestingLimit nestingLimit(
+      numeric_limits<uint8_t>::highest());
+  DeserializationError err;
+  JsonString json = var->asLazy();
+  if (json.isLinked()) {
+    // The text lives in the mutable input, so we can move the strings in place
+    char* text = const_cast<char*>(json.c_str());
+    err = makeDeserializer<JsonDeserializer>(
+              pool, makeReader(text, json.size()), StringMover(text))
+              .parse(*var, AllowAllFilter(), nestingLimit);
+  } else {
+    err = makeDeserializer<JsonDeserializer>(
+              pool, makeReader(json.c_str(), json.size()), StringCopier(pool))
+              .parse(*var, AllowAllFilter(), nestingLimit);
+  }
+
+  // A failed parse leaves a partial value and may have moved the text of a
+  // mutable input, so the value can't stay lazy.
+  if (err)
+    var->setNull();
+
+  return var;
+}
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
 
 ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
@@ -690,4 +1204,25 @@ DeserializationError deserializeJson(JsonDocument& doc, TChar* input,
                                        detail::forward<Args>(args)...);
 }
 
+// Parses a JSON input into a variant of an existing document.
+// The document isn't cleared; objects are merged with the existing members.
+template <typename TVariant, typename... Args>
+typename detail::enable_if<detail::IsVariant<TVariant>::value,
+                           DeserializationError>::type
+deserializeJson(const TVariant& dst, Args&&... args) {
+  using namespace detail;
+  return deserialize<JsonDeserializer>(dst, detail::forward<Args>(args)...);
+}
+
+// Parses a JSON input into a variant of an existing document.
+// The document isn't cleared; objects are merged with the existing members.
+template <typename TVariant, typename TChar, typename... Args>
+typename detail::enable_if<detail::IsVariant<TVariant>::value,
+                           DeserializationError>::type
+deserializeJson(const TVariant& dst, TChar* input, Args&&... args) {
+  using namespace detail;
+  return deserialize<JsonDeserializer>(dst, input,
+                                       detail::forward<Args>(args)...);
+}
+
 ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,247 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Json/JsonPointer.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A node in the tree of bound paths
+struct ExtractionNode {
+  const char* token;  // in the bound path, after the '/'
+  size_t firstChild;  // 0 means none (the root is never a child)
+  size_t nextSibling;
+  void* destination;
+  void (*assign)(void* destination, JsonVariantConst value);
+  bool extracted;
+};
+
+template <typename T>
+void assignExtractedValue(void* destination, JsonVariantConst value) {
+  *static_cast<T*>(destination) = value.as<T>();
+}
+
+// Returns true if both reference tokens are identical
+inline bool extractionTokenEquals(const char* a, const char* b) {
+  for (;;) {
+    bool aEnds = *a == '\0' || *a == '/';
+    bool bEnds = *b == '\0' || *b == '/';
+    if (aEnds || bEnds)
+      return aEnds && bEnds;
+    if (*a++ != *b++)
+      return false;
+  }
+}
+
+struct ExtractionContext {
+  VariantData* data;
+  MemoryPool* pool;
+  size_t remaining;
+};
+
+// A position in the tree of bound paths, used by JsonDeserializer::extract()
+// to decide which branches to descend into.
+class ExtractionPlanPath {
+ public:
+  ExtractionPlanPath(ExtractionNode* nodes, ExtractionNode* node,
+                     ExtractionContext* context)
+      : nodes_(nodes), node_(node), context_(context) {}
+
+  bool allow() const {
+    return node_ != 0;
+  }
+
+  VariantData* target() const {
+    return node_ && node_->assign && !node_->extracted ? context_->data : 0;
+  }
+
+  void commit() {
+    if (!context_->data->isNull())
+      node_->assign(node_->destination, JsonVariantConst(context_->data));
+    node_->extracted = true;
+    context_->remaining--;
+
+    // recycle the temporary pool for the next target
+    context_->data->setNull();
+    context_->pool->clear();
+  }
+
+  bool done() const {
+    return context_->remaining == 0;
+  }
+
+  template <typename TKey>
+  ExtractionPlanPath operator[](TKey key) const {
+    if (node_) {
+      for (size_t i = node_->firstChild; i; i = nodes_[i].nextSibling) {
+        if (jsonPointerMatch(nodes_[i].token, key))
+          return ExtractionPlanPath(nodes_, &nodes_[i], context_);
+      }
+    }
+    return ExtractionPlanPath(nodes_, 0, context_);
+  }
+
+ private:
+  ExtractionNode* nodes_;
+  ExtractionNode* node_;  // null if the path doesn't match
+  ExtractionContext* context_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// A compiled list of JSON Pointers bound to output variables.
+// extractJson() evaluates all of them in a single pass over the input, without
+// building a document, and writes the values directly to their destinations.
+// N is the number of distinct reference tokens in the bound paths; for example,
+// "/a/b" and "/a/c" need 3.
+template <size_t N>
+class JsonExtractionPlan {
+ public:
+  JsonExtractionPlan() : size_(1), targets_(0) {
+    nodes_[0] = detail::ExtractionNode();
+  }
+
+  // Binds the value at the specified JSON Pointer to a variable.
+  // The path must outlive the plan, and so must the destination.
+  // The value goes through a temporary pool of
+  // ARDUINOJSON_EXTRACTION_BUFFER_SIZE bytes, so T must own its content (e.g.
+  // int64_t, double, std::string). The destination is left untouched if the
+  // value is missing or null.
+  // Returns false if the path is invalid, if the plan is full, or if the path
+  // overlaps with a bound path (e.g. "/a" and "/a/b"), because the value of
+  // the shorter one is extracted in place of its descendants.
+  template <typename T>
+  typename detail::enable_if<detail::IsOwningExtractionTarget<T>::value,
+                             bool>::type
+  bind(const char* path, T* destination) {
+    if (!path || !destination)
+      return false;
+    size_t previousSize = size_;
+    size_t node = 0;
+    while (*path == '/') {
+      if (nodes_[node].assign)  // a prefix is bound
+        return false;
+      node = getOrAddChild(node, ++path);
+      if (!node) {
+        // don't leave the nodes of a partial path in the tree
+        removeNodesFrom(previousSize);
+        return false;
+      }
+      while (*path && *path != '/')
+        path++;
+    }
+    if (*path)
+      return false;
+    if (nodes_[node].firstChild)  // a descendant is bound
+      return false;
+    if (!nodes_[node].assign)
+      targets_++;
+    nodes_[node].destination = destination;
+    nodes_[node].assign = &detail::assignExtractedValue<T>;
+    return true;
+  }
+
+  // Returns the number of bound variables.
+  size_t size() const {
+    return targets_;
+  }
+
+  // INTERNAL USE ONLY
+  detail::ExtractionPlanPath root(detail::ExtractionContext* context) {
+    for (size_t i = 0; i < size_; i++)
+      nodes_[i].extracted = false;
+    context->remaining = targets_;
+    return detail::ExtractionPlanPath(nodes_, nodes_, context);
+  }
+
+ private:
+  size_t getOrAddChild(size_t parent, const char* token) {
+    size_t* link = &nodes_[parent].firstChild;
+    while (*link) {
+      if (detail::extractionTokenEquals(nodes_[*link].token, token))
+        return *link;
+      link = &nodes_[*link].nextSibling;
+    }
+    if (size_ > N)
+      return 0;
+    nodes_[size_] = detail::ExtractionNode();
+    nodes_[size_].token = token;
+    *link = size_;
+    return size_++;
+  }
+
+  // Removes the nodes added since the plan had the specified size
+  void removeNodesFrom(size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      if (nodes_[i].firstChild >= size)
+        nodes_[i].firstChild = 0;
+      if (nodes_[i].nextSibling >= size)
+        nodes_[i].nextSibling = 0;
+    }
+    size_ = size;
+  }
+
+  detail::ExtractionNode nodes_[N + 1];  // nodes_[0] is the root
+  size_t size_;
+  size_t targets_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+template <typename TReader, typename TInput, size_t N>
+DeserializationError runExtractionPlan(
+    TReader reader, TInput& input, JsonExtractionPlan<N>& plan,
+    DeserializationOption::NestingLimit nestingLimit) {
+  StaticJsonDocument<ARDUINOJSON_EXTRACTION_BUFFER_SIZE> scratch;
+  ExtractionContext context;
+  context.data = VariantAttorney::getData(scratch);
+  context.pool = VariantAttorney::getPool(scratch);
+  ExtractionPlanPath root = plan.root(&context);
+  if (root.done())
+    return DeserializationError::Ok;
+  return makeDeserializer<JsonDeserializer>(
+             context.pool, reader, makeStringStorage(input, context.pool))
+      .extract(root, nestingLimit);
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Extracts all the values bound in the plan in a single pass over the input.
+// Stops reading as soon as all the values are complete.
+template <typename TInput, size_t N>
+DeserializationError extractJson(
+    TInput&& input, JsonExtractionPlan<N>& plan,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return runExtractionPlan(makeReader(detail::forward<TInput>(input)), input,
+                           plan, nestingLimit);
+}
+
+// Extracts all the values bound in the plan in a single pass over the input.
+template <typename TChar, size_t N>
+DeserializationError extractJson(
+    TChar* input, JsonExtractionPlan<N>& plan,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return runExtractionPlan(makeReader(input), input, plan, nestingLimit);
+}
+
+// Extracts all the values bound in the plan in a single pass over the input.
+template <typename TChar, size_t N>
+DeserializationError extractJson(
+    TChar* input, size_t inputSize, JsonExtractionPlan<N>& plan,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return runExtractionPlan(makeReader(input, inputSize), input, plan,
+                           nestingLimit);
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,190 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/StaticJsonDocument.hpp>
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Returns the end of the current reference token if it matches the key.
+// The token starts after the '/' and ends before the next '/' or the
+// terminator. "~0" and "~1" are unescaped to '~' and '/' (RFC 6901).
+inline const char* jsonPointerMatch(const char* token, const char* key) {
+  for (;;) {
+    char c = *token;
+    if (c == '\0' || c == '/')
+      return *key == '\0' ? token : 0;
+    if (c == '~') {
+      c = *++token;
+      if (c == '0')
+        c = '~';
+      else if (c == '1')
+        c = '/';
+      else
+        return 0;
+    }
+    if (c != *key)
+      return 0;
+    ++token;
+    ++key;
+  }
+}
+
+// Returns the end of the current reference token if it matches the index.
+// Leading zeros are not allowed (RFC 6901).
+inline const char* jsonPointerMatch(const char* token, size_t index) {
+  if (*token == '0' && token[1] != '\0' && token[1] != '/')
+    return 0;
+  size_t value = 0;
+  const char* p = token;
+  while (*p >= '0' && *p <= '9')
+    value = value * 10 + size_t(*p++ - '0');
+  if (p == token || (*p != '\0' && *p != '/'))
+    return 0;
+  return value == index ? p : 0;
+}
+
+// A position in a JSON Pointer, used by JsonDeserializer::extract() to decide
+// which branches to descend into.
+class JsonPointerPath {
+ public:
+  JsonPointerPath(const char* pointer, VariantData* target, bool* done)
+      : pointer_(pointer), target_(target), done_(done) {}
+
+  bool allow() const {
+    return pointer_ != 0;
+  }
+
+  VariantData* target() const {
+    return pointer_ && *pointer_ == '\0' ? target_ : 0;
+  }
+
+  void commit() {
+    *done_ = true;
+  }
+
+  bool done() const {
+    return *done_;
+  }
+
+  JsonPointerPath operator[](const char* key) const {
+    return next(pointer_ && *pointer_ == '/'
+                    ? jsonPointerMatch(pointer_ + 1, key)
+                    : 0);
+  }
+
+  JsonPointerPath operator[](size_t index) const {
+    return next(pointer_ && *pointer_ == '/'
+                    ? jsonPointerMatch(pointer_ + 1, index)
+                    : 0);
+  }
+
+ private:
+  JsonPointerPath next(const char* pointer) const {
+    return JsonPointerPath(pointer, target_, done_);
+  }
+
+  const char* pointer_;  // null if the path doesn't match
+  VariantData* target_;
+  bool* done_;
+};
+
+template <typename TReader, typename TInput>
+DeserializationError extractJson(
+    TReader reader, TInput& input, const char* pointer, JsonVariant output,
+    DeserializationOption::NestingLimit nestingLimit) {
+  auto data = VariantAttorney::getOrCreateData(output);
+  auto pool = VariantAttorney::getPool(output);
+  if (!data || !pool)
+    return DeserializationError::NoMemory;
+  data->setNull();
+  if (!pointer)
+    return DeserializationError::Ok;
+  bool done = false;
+  return makeDeserializer<JsonDeserializer>(pool, reader,
+                                            makeStringStorage(input, pool))
+      .extract(JsonPointerPath(pointer, data, &done), nestingLimit);
+}
+
+template <typename T>
+struct IsOwningExtractionTarget {
+  static const bool value = !is_convertible<T, JsonVariant>::value &&
+                            !is_pointer<T>::value &&
+                            !is_same<T, JsonString>::value;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Extracts the value at the specified JSON Pointer (e.g. "/a/b/3") without
+// building a document. Skips everything outside the path, stores only the
+// target in the variant's memory pool, and stops reading as soon as the target
+// is complete. The output is null if the pointer doesn't match.
+template <typename TInput>
+DeserializationError extractJson(
+    TInput&& input, const char* pointer, JsonVariant output,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return extractJson(makeReader(detail::forward<TInput>(input)), input,
+                     pointer, output, nestingLimit);
+}
+
+// Extracts the value at the specified JSON Pointer without building a
+// document.
+template <typename TChar>
+DeserializationError extractJson(
+    TChar* input, const char* pointer, JsonVariant output,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return extractJson(makeReader(input), input, pointer, output,
+                     nestingLimit);
+}
+
+// Extracts the value at the specified JSON Pointer without building a
+// document.
+template <typename TChar>
+DeserializationError extractJson(
+    TChar* input, size_t inputSize, const char* pointer, JsonVariant output,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return extractJson(makeReader(input, inputSize), input, pointer,
+                     output, nestingLimit);
+}
+
+// Extracts the value at the specified JSON Pointer and converts it to T.
+// The value goes through a temporary pool of ARDUINOJSON_EXTRACTION_BUFFER_SIZE
+// bytes, so T must own its content (e.g. int, double, std::string).
+// The value is left untouched if the pointer doesn't match.
+template <typename T, typename TInput>
+typename detail::enable_if<detail::IsOwningExtractionTarget<T>::value,
+                           DeserializationError>::type
+extractJson(TInput&& input, const char* pointer, T& value,
+            DeserializationOption::NestingLimit nestingLimit = {}) {
+  StaticJsonDocument<ARDUINOJSON_EXTRACTION_BUFFER_SIZE> doc;
+  DeserializationError err =
+      extractJson(detail::forward<TInput>(input), pointer,
+                  doc.to<JsonVariant>(), nestingLimit);
+  if (!err && !doc.isNull())
+    value = doc.as<T>();
+  return err;
+}
+
+// Extracts the value at the specified JSON Pointer and converts it to T.
+template <typename T, typename TChar>
+typename detail::enable_if<detail::IsOwningExtractionTarget<T>::value,
+                           DeserializationError>::type
+extractJson(TChar* input, size_t inputSize, const char* pointer, T& value,
+            DeserializationOption::NestingLimit nestingLimit = {}) {
+  StaticJsonDocument<ARDUINOJSON_EXTRACTION_BUFFER_SIZE> doc;
+  DeserializationError err = extractJson(input, inputSize, pointer,
+                                         doc.to<JsonVariant>(), nestingLimit);
+  if (!err && !doc.isNull())
+    value = doc.as<T>();
+  return err;
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
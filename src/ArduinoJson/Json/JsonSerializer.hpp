@@ -73,6 +73,11 @@ class JsonSerializer : public Visitor<size_t> {
     return bytesWritten();
   }
 
+  size_t visitBinary(JsonBinary value) {
+    formatter_.writeBase64(value.data(), value.size());
+    return bytesWritten();
+  }
+
   size_t visitRawJson(const char* data, size_t n) {
     formatter_.writeRaw(data, n);
     return bytesWritten();
@@ -98,6 +103,33 @@ class JsonSerializer : public Visitor<size_t> {
     return bytesWritten();
   }
 
+  // The following functions write arrays and objects piece by piece
+
+  void beginArray() {
+    write('[');
+  }
+
+  void endArray() {
+    write(']');
+  }
+
+  void beginObject() {
+    write('{');
+  }
+
+  void endObject() {
+    write('}');
+  }
+
+  void writeComma() {
+    write(',');
+  }
+
+  void writeKey(const char* key, size_t n) {
+    formatter_.writeString(key, n);
+    write(':');
+  }
+
  protected:
   size_t bytesWritten() const {
     return formatter_.bytesWritten();
@@ -52,6 +52,37 @@ class TextFormatter {
     writeRaw('\"');
   }
 
+  // Writes the bytes as a base64 string.
+  // Encodes 3 bytes at a time and writes the characters by blocks.
+  void writeBase64(const uint8_t* data, size_t n) {
+    char buffer[64];  // a multiple of 4
+    size_t len = 0;
+
+    writeRaw('\"');
+    for (; n >= 3; n -= 3, data += 3) {
+      uint32_t v = uint32_t(data[0]) << 16 | uint32_t(data[1]) << 8 | data[2];
+      buffer[len++] = base64Char(v >> 18);
+      buffer[len++] = base64Char(v >> 12);
+      buffer[len++] = base64Char(v >> 6);
+      buffer[len++] = base64Char(v);
+      if (len == sizeof(buffer)) {
+        writeRaw(buffer, len);
+        len = 0;
+      }
+    }
+    if (n) {
+      uint32_t v = uint32_t(data[0]) << 16;
+      if (n == 2)
+        v |= uint32_t(data[1]) << 8;
+      buffer[len++] = base64Char(v >> 18);
+      buffer[len++] = base64Char(v >> 12);
+      buffer[len++] = n == 2 ? base64Char(v >> 6) : '=';
+      buffer[len++] = '=';
+    }
+    writeRaw(buffer, len);
+    writeRaw('\"');
+  }
+
   void writeChar(char c) {
     char specialChar = EscapeSequence::escapeChar(c);
     if (specialChar) {
@@ -166,6 +197,19 @@ class TextFormatter {
     writer_.write(static_cast<uint8_t>(c));
   }
 
+ private:
+  // Optimized for code size on a 8-bit AVR
+  static char base64Char(uint32_t v) {
+    uint8_t i = uint8_t(v & 0x3F);
+    if (i < 26)
+      return char('A' + i);
+    if (i < 52)
+      return char('a' + i - 26);
+    if (i < 62)
+      return char('0' + i - 52);
+    return i == 62 ? '+' : '/';
+  }
+
  protected:
   CountingDecorator<TWriter> writer_;
 };
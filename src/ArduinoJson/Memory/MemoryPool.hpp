@@ -10,7 +10,8 @@
 #include <ArduinoJson/Strings/StringAdapters.hpp>
 #include <ArduinoJson/Variant/VariantSlot.hpp>
 
-#include <string.h>  // memmove
+#include <stdint.h>  // uintptr_t
+#include <string.h>  // memcpy, memmove
 
 #define JSON_STRING_SIZE(SIZE) (SIZE + 1)
 
@@ -26,6 +27,13 @@
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
+// Allocates the additional blocks of a growable MemoryPool
+struct BlockAllocator {
+  void* (*allocate)(void* context, size_t size);
+  void (*deallocate)(void* context, void* ptr);
+  void* context;
+};
+
 // begin_                                   end_
 // v                                           v
 // +-------------+--------------+--------------+
@@ -33,6 +41,10 @@ ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 // +-------------+--------------+--------------+
 //               ^              ^
 //             left_          right_
+//
+// A growable pool chains additional blocks, obtained from a BlockAllocator,
+// when the current one is full. Each block has the layout above, preceded by a
+// BlockHeader. The first block is the buffer passed to the constructor.
 
 class MemoryPool {
  public:
@@ -41,24 +53,56 @@ class MemoryPool {
         left_(buf),
         right_(buf ? buf + capa : 0),
         end_(buf ? buf + capa : 0),
-        overflowed_(false) {
+        overflowed_(false),
+        growable_(false),
+        buffer_(buf),
+        bufferEnd_(end_),
+        blocks_(0),
+        retiredSize_(0),
+        retiredCapacity_(0),
+        freeVariants_(0) {
     ARDUINOJSON_ASSERT(isAligned(begin_));
     ARDUINOJSON_ASSERT(isAligned(right_));
     ARDUINOJSON_ASSERT(isAligned(end_));
+    allocator_.allocate = 0;
+    allocator_.deallocate = 0;
+    allocator_.context = 0;
+    clearFreeStrings();
   }
 
   void* buffer() {
-    return begin_;  // NOLINT(clang-analyzer-unix.Malloc)
-                    // movePointers() alters this pointer
+    return buffer_;  // NOLINT(clang-analyzer-unix.Malloc)
+                     // movePointers() alters this pointer
   }
 
   // Gets the capacity of the memoryPool in bytes
   size_t capacity() const {
-    return size_t(end_ - begin_);
+    return retiredCapacity_ + size_t(end_ - begin_);
   }
 
   size_t size() const {
-    return size_t(left_ - begin_ + end_ - right_);
+    return retiredSize_ + size_t(left_ - begin_ + end_ - right_);
+  }
+
+  // Sets the allocator of the additional blocks. It must also be set to
+  // release them when the pool isn't growable anymore.
+  void setBlockAllocator(BlockAllocator allocator) {
+    allocator_ = allocator;
+  }
+
+  // Allows the pool to chain additional blocks when the current one is full.
+  void setGrowable(bool growable) {
+    growable_ = growable;
+  }
+
+  bool growable() const {
+    return growable_;
+  }
+
+  // Returns true if the pool chained additional blocks; squash(),
+  // movePointers(), and the snapshots only support a single block.
+  bool hasAdditionalBlocks() const {
+    return blocks_ != 0;
   }
 
   bool overflowed() const {
@@ -66,9 +110,51 @@ class MemoryPool {
   }
 
   VariantSlot* allocVariant() {
+    if (freeVariants_) {
+      VariantSlot* slot = freeVariants_;
+      freeVariants_ = nextFreeVariant(slot);
+      return slot;
+    }
     return allocRight<VariantSlot>();
   }
 
+  // Gives back a slot removed from its collection; allocVariant() reuses it.
+  // The memory stays counted in size().
+  void freeVariant(VariantSlot* slot) {
+    ARDUINOJSON_ASSERT(owns(slot));
+    nextFreeVariant(slot) = freeVariants_;
+    freeVariants_ = slot;
+  }
+
+  // Gives back the n bytes of a string that isn't used anymore; saveString()
+  // reuses them. The strings can't be recycled when deduplication is enabled,
+  // since several values may share them.
+  void freeString(const char* s, size_t n) {
+#if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+    (void)s;
+    (void)n;
+#else
+    ARDUINOJSON_ASSERT(owns(const_cast<char*>(s)));
+    if (n < sizeof(char*))  // too small to hold the link
+      return;
+    size_t i = 0;
+    while (i + 1 < freeStringBuckets && (sizeof(char*) << (i + 1)) <= n)
+      i++;
+    char* chunk = const_cast<char*>(s);
+    memcpy(chunk, &freeStrings_[i], sizeof(char*));  // may be unaligned
+    freeStrings_[i] = chunk;
+#endif
+  }
+
+  // Allocates n contiguous slots, in increasing order of address
+  VariantSlot* allocVariants(size_t n) {
+    if (n > size_t(-1) / sizeof(VariantSlot)) {
+      overflowed_ = true;
+      return 0;
+    }
+    return reinterpret_cast<VariantSlot*>(allocRight(n * sizeof(VariantSlot)));
+  }
+
   template <typename TAdaptedString>
   const char* saveString(TAdaptedString str) {
     if (str.isNull())
@@ -90,6 +176,17 @@ class MemoryPool {
     return newCopy;
   }
 
+#if ARDUINOJSON_COMPACT_SLOTS
+  // Copies a pointer in the strings zone, so that a slot can reach a linked
+  // key through a 32-bit offset (see VariantSlot::key_)
+  const char* savePointer(const char* p) {
+    char* copy = allocString(sizeof(p));
+    if (copy)
+      memcpy(copy, &p, sizeof(p));  // may be unaligned
+    return copy;
+  }
+#endif
+
   void getFreeZone(char** zoneStart, size_t* zoneSize) const {
     *zoneStart = left_;
     *zoneSize = size_t(right_ - left_);
@@ -109,22 +206,85 @@ class MemoryPool {
     return str;
   }
 
+  // Moves the string being built at the beginning of the free zone to a new
+  // block with room for `required` bytes. The first `used` bytes are copied.
+  // Returns false if the pool can't grow.
+  bool growFreeZone(size_t used, size_t required) {
+    ARDUINOJSON_ASSERT(used <= required);
+    const char* str = left_;
+    if (!addBlock(required)) {
+      overflowed_ = true;
+      return false;
+    }
+    memcpy(left_, str, used);
+    return true;
+  }
+
+  // Returns the number of bytes used by the strings, from buffer()
+  size_t stringsSize() const {
+    return size_t(left_ - begin_);
+  }
+
+  // Returns the first variant, the others follow up to the end of the pool
+  void* variants() {
+    return right_;
+  }
+
+  // Returns the number of bytes used by the variants
+  size_t variantsSize() const {
+    return size_t(end_ - right_);
+  }
+
+  // Empties the pool and allocates both zones at once, so that their content
+  // can be copied from a snapshot, or kept after a PoolCompactor slid it.
+  // Returns false if they don't fit.
+  bool allocZones(size_t stringsSize, size_t variantsSize) {
+    clear();
+    if (stringsSize > capacity() || variantsSize > capacity() - stringsSize ||
+        !isAligned(variantsSize)) {
+      overflowed_ = true;
+      return false;
+    }
+    left_ += stringsSize;
+    right_ -= variantsSize;
+    checkInvariants();
+    return true;
+  }
+
   void markAsOverflowed() {
     overflowed_ = true;
   }
 
+  // Empties the pool and releases the additional blocks
   void clear() {
+    freeVariants_ = 0;
+    clearFreeStrings();
+    while (blocks_) {
+      BlockHeader* previous = blocks_->previous;
+      allocator_.deallocate(allocator_.context, blocks_);
+      blocks_ = previous;
+    }
+    retiredSize_ = 0;
+    retiredCapacity_ = 0;
+    begin_ = buffer_;
+    end_ = bufferEnd_;
     left_ = begin_;
     right_ = end_;
     overflowed_ = false;
   }
 
   bool canAlloc(size_t bytes) const {
-    return left_ + bytes <= right_;
+    return bytes <= size_t(right_ - left_);
   }
 
   bool owns(void* p) const {
-    return begin_ <= p && p < end_;
+    if (buffer_ <= p && p < bufferEnd_)
+      return true;
+    for (BlockHeader* block = blocks_; block; block = block->previous) {
+      if (block->begin() <= p && p < block->end)
+        return true;
+    }
+    return false;
   }
 
   // Workaround for missing placement new
@@ -144,6 +304,10 @@ class MemoryPool {
   //
   // This funcion is called before a realloc.
   ptrdiff_t squash() {
+    ARDUINOJSON_ASSERT(!blocks_);
+    // the free slots and strings move, and are lost
+    freeVariants_ = 0;
+    clearFreeStrings();
     char* new_right = addPadding(left_);
     if (new_right >= right_)
       return 0;
@@ -154,12 +318,16 @@ class MemoryPool {
     ptrdiff_t bytes_reclaimed = right_ - new_right;
     right_ = new_right;
     end_ = new_right + right_size;
+    bufferEnd_ = end_;
     return bytes_reclaimed;
   }
 
   // Move all pointers together
   // This funcion is called after a realloc.
   void movePointers(ptrdiff_t offset) {
+    ARDUINOJSON_ASSERT(!blocks_);
+    buffer_ += offset;
+    bufferEnd_ += offset;
     begin_ += offset;
     left_ += offset;
     right_ += offset;
@@ -167,6 +335,97 @@ class MemoryPool {
   }
 
  private:
+  struct BlockHeader {
+    BlockHeader* previous;
+    char* end;
+
+    char* begin() {
+      return reinterpret_cast<char*>(this) +
+             AddPadding<sizeof(BlockHeader)>::value;
+    }
+  };
+
+  // Chains a block with room for `required` bytes, unless the pool isn't
+  // growable or the allocator fails.
+  bool addBlock(size_t required) {
+    if (!growable_ || required > size_t(-1) / 2)
+      return false;
+    // the blocks are at least as large as the first one
+    size_t capa = addPadding(required);
+    if (capa < size_t(bufferEnd_ - buffer_))
+      capa = size_t(bufferEnd_ - buffer_);
+    size_t blockSize =
+        AddPadding<sizeof(BlockHeader)>::value + capa + sizeof(VariantSlot);
+    BlockHeader* block = reinterpret_cast<BlockHeader*>(
+        allocator_.allocate(allocator_.context, blockSize));
+    if (!block)
+      return false;
+    block->end = block->begin() + capa;
+    block->end += slotMisalignment(block->end);
+    if (!isInRange(block)) {
+      allocator_.deallocate(allocator_.context, block);
+      return false;
+    }
+    block->previous = blocks_;
+    blocks_ = block;
+    retiredSize_ += size_t(left_ - begin_ + end_ - right_);
+    retiredCapacity_ += size_t(end_ - begin_);
+    begin_ = left_ = block->begin();
+    end_ = right_ = block->end;
+    return true;
+  }
+
+  // The offsets between slots are counted in slots, so the slots of all the
+  // blocks must be a whole number of slots away from the first block's.
+  // Returns the number of bytes to add to `end` to ensure that.
+  size_t slotMisalignment(const char* end) const {
+    uintptr_t a = uintptr_t(end), b = uintptr_t(bufferEnd_);
+    if (a >= b)
+      return size_t((sizeof(VariantSlot) - (a - b) % sizeof(VariantSlot)) %
+                    sizeof(VariantSlot));
+    else
+      return size_t((b - a) % sizeof(VariantSlot));
+  }
+
+  // The slots of a collection are linked by relative offsets (see
+  // VariantSlot::next_), so all the blocks must be within their range.
+  // With ARDUINOJSON_COMPACT_SLOTS, the keys are 32-bit offsets too.
+  bool isInRange(BlockHeader* newBlock) const {
+    uintptr_t lowest = uintptr_t(newBlock);
+    uintptr_t highest = uintptr_t(newBlock->end);
+    if (buffer_) {
+      if (uintptr_t(buffer_) < lowest)
+        lowest = uintptr_t(buffer_);
+      if (uintptr_t(bufferEnd_) > highest)
+        highest = uintptr_t(bufferEnd_);
+    }
+    for (BlockHeader* block = blocks_; block; block = block->previous) {
+      if (uintptr_t(block) < lowest)
+        lowest = uintptr_t(block);
+      if (uintptr_t(block->end) > highest)
+        highest = uintptr_t(block->end);
+    }
+#if ARDUINOJSON_COMPACT_SLOTS
+    if (highest - lowest > uintptr_t(numeric_limits<int32_t>::highest()))
+      return false;
+#endif
+    return (highest - lowest) / sizeof(VariantSlot) <=
+           uintptr_t(numeric_limits<VariantSlotDiff>::highest());
+  }
+
+  // The link to the next free slot is stored in the free slot itself
+  static VariantSlot*& nextFreeVariant(VariantSlot* slot) {
+    void* p = slot;  // prevent warning cast-align
+    return *reinterpret_cast<VariantSlot**>(p);
+  }
+
+  void clearFreeStrings() {
+#if !ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+    for (size_t i = 0; i < freeStringBuckets; i++)
+      freeStrings_[i] = 0;
+#endif
+  }
+
   void checkInvariants() {
     ARDUINOJSON_ASSERT(begin_ <= left_);
     ARDUINOJSON_ASSERT(left_ <= right_);
@@ -191,7 +450,17 @@ class MemoryPool {
 #endif
 
   char* allocString(size_t n) {
-    if (!canAlloc(n)) {
+#if !ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+    // bucket i holds chunks of at least sizeof(char*) << i bytes
+    for (size_t i = 0; i < freeStringBuckets; i++) {
+      if ((sizeof(char*) << i) < n || !freeStrings_[i])
+        continue;
+      char* chunk = freeStrings_[i];
+      memcpy(&freeStrings_[i], chunk, sizeof(char*));
+      return chunk;
+    }
+#endif
+    if (!canAlloc(n) && !addBlock(n)) {
       overflowed_ = true;
       return 0;
     }
@@ -207,7 +476,7 @@ class MemoryPool {
   }
 
   void* allocRight(size_t bytes) {
-    if (!canAlloc(bytes)) {
+    if (!canAlloc(bytes) && !addBlock(bytes)) {
       overflowed_ = true;
       return 0;
     }
@@ -217,6 +486,16 @@ class MemoryPool {
 
   char *begin_, *left_, *right_, *end_;
   bool overflowed_;
+  bool growable_;
+  char *buffer_, *bufferEnd_;  // the first block
+  BlockHeader* blocks_;        // the additional blocks, the last one first
+  size_t retiredSize_, retiredCapacity_;  // of the blocks before the current
+  BlockAllocator allocator_;
+  VariantSlot* freeVariants_;
+#if !ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+  static const size_t freeStringBuckets = 8;
+  char* freeStrings_[freeStringBuckets];
+#endif
 };
 
 template <typename TAdaptedString, typename TCallback>
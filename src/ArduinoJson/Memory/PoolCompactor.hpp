@@ -0,0 +1,226 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/MemoryPool.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+#include <stdint.h>  // uint8_t
+#include <string.h>  // memmove, memset
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+inline uint8_t countBits(uint8_t x) {
+  x = uint8_t(x - ((x >> 1) & 0x55));
+  x = uint8_t((x & 0x33) + ((x >> 2) & 0x33));
+  return uint8_t((x + (x >> 4)) & 0x0F);
+}
+
+// A bitmap that counts the bits set before a position in constant time, thanks
+// to a running total every 256 bits.
+class RankedBitmap {
+  static const size_t bitsPerRank = 256;
+  static const size_t bytesPerRank = bitsPerRank / 8;
+
+ public:
+  RankedBitmap() : ranks_(0), bits_(0), size_(0), count_(0) {}
+
+  // Returns the number of bytes needed to store n bits
+  static size_t storageSize(size_t n) {
+    return rankCount(n) * (sizeof(size_t) + bytesPerRank);
+  }
+
+  // The storage must be aligned and hold storageSize(n) bytes
+  void init(void* storage, size_t n) {
+    ranks_ = reinterpret_cast<size_t*>(storage);
+    bits_ = reinterpret_cast<uint8_t*>(ranks_ + rankCount(n));
+    size_ = n;
+    count_ = 0;
+    if (n)
+      memset(bits_, 0, rankCount(n) * bytesPerRank);
+  }
+
+  void set(size_t i) {
+    ARDUINOJSON_ASSERT(i < size_);
+    bits_[i / 8] = uint8_t(bits_[i / 8] | (1 << (i % 8)));
+  }
+
+  bool test(size_t i) const {
+    ARDUINOJSON_ASSERT(i < size_);
+    return ((bits_[i / 8] >> (i % 8)) & 1) != 0;
+  }
+
+  // Computes the running totals, call it after the last set()
+  void index() {
+    count_ = 0;
+    for (size_t r = 0; r < rankCount(size_); r++) {
+      ranks_[r] = count_;
+      for (size_t i = 0; i < bytesPerRank; i++)
+        count_ += countBits(bits_[r * bytesPerRank + i]);
+    }
+  }
+
+  // Returns the number of bits set before position i
+  size_t rank(size_t i) const {
+    ARDUINOJSON_ASSERT(i < size_);
+    size_t result = ranks_[i / bitsPerRank];
+    for (size_t j = i / bitsPerRank * bytesPerRank; j < i / 8; j++)
+      result += countBits(bits_[j]);
+    return result + countBits(uint8_t(bits_[i / 8] & ((1 << (i % 8)) - 1)));
+  }
+
+  // Returns the number of bits set
+  size_t count() const {
+    return count_;
+  }
+
+ private:
+  static size_t rankCount(size_t n) {
+    return (n + bitsPerRank - 1) / bitsPerRank;
+  }
+
+  size_t* ranks_;
+  uint8_t* bits_;
+  size_t size_;
+  size_t count_;
+};
+
+// Compacts a MemoryPool made of a single block, in place:
+// 1. marks the strings and the slots reachable from the root,
+// 2. replaces the pointers with the addresses computed from the marks,
+// 3. slides the live strings to the left and the live slots to the right.
+// The marks take one bit per byte of string and one bit per slot, plus the
+// running totals, in a scratch buffer that can be the free zone of the pool.
+class PoolCompactor {
+ public:
+  PoolCompactor(MemoryPool* pool)
+      : pool_(pool),
+        strings_(reinterpret_cast<char*>(pool->buffer())),
+        stringsSize_(pool->stringsSize()),
+        slots_(reinterpret_cast<VariantSlot*>(pool->variants())),
+        slotCount_(pool->variantsSize() / sizeof(VariantSlot)) {
+    ARDUINOJSON_ASSERT(!pool->hasAdditionalBlocks());
+  }
+
+  // Returns the size of the scratch buffer that compact() needs
+  size_t scratchSize() const {
+    return RankedBitmap::storageSize(stringsSize_) +
+           RankedBitmap::storageSize(slotCount_);
+  }
+
+  // Compacts the pool, using its free zone as the scratch buffer.
+  // Returns false if the free zone is too small.
+  bool compactInFreeZone(VariantData* root) {
+    char* zone;
+    size_t zoneSize;
+    pool_->getFreeZone(&zone, &zoneSize);
+    char* scratch = addPadding(zone);
+    size_t padding = size_t(scratch - zone);
+    if (padding > zoneSize || scratchSize() > zoneSize - padding)
+      return false;
+    compact(root, scratch);
+    return true;
+  }
+
+  // The scratch buffer must be aligned and hold scratchSize() bytes
+  void compact(VariantData* root, void* scratch) {
+    liveStrings_.init(scratch, stringsSize_);
+    liveSlots_.init(reinterpret_cast<char*>(scratch) +
+                        RankedBitmap::storageSize(stringsSize_),
+                    slotCount_);
+
+    root->mark(*this);
+    liveStrings_.index();
+    liveSlots_.index();
+
+    // each slot is updated once, even if shallowCopy() shares it
+    root->relocate(*this);
+    for (size_t i = 0; i < slotCount_; i++) {
+      if (liveSlots_.test(i))
+        slots_[i].relocate(*this);
+    }
+
+    slideStrings();
+    slideSlots();
+    pool_->allocZones(liveStrings_.count(),
+                      liveSlots_.count() * sizeof(VariantSlot));
+  }
+
+  void markString(const char* s, size_t n) {
+    if (!ownsString(s))  // shallowCopy() of another document
+      return;
+    size_t offset = size_t(s - strings_);
+    for (size_t i = 0; i < n; i++)
+      liveStrings_.set(offset + i);
+  }
+
+  // Returns false if the slot was already marked or isn't in the pool
+  bool markSlot(const VariantSlot* slot) {
+    if (!ownsSlot(slot))
+      return false;
+    size_t index = size_t(slot - slots_);
+    if (liveSlots_.test(index))
+      return false;
+    liveSlots_.set(index);
+    return true;
+  }
+
+  const char* newAddress(const char* s) const {
+    if (!ownsString(s))
+      return s;
+    return strings_ + liveStrings_.rank(size_t(s - strings_));
+  }
+
+  VariantSlot* newAddress(VariantSlot* slot) const {
+    if (!ownsSlot(slot))
+      return slot;
+    // the live slots that follow this one keep their order
+    size_t index = size_t(slot - slots_);
+    return slots_ + slotCount_ - (liveSlots_.count() - liveSlots_.rank(index));
+  }
+
+ private:
+  bool ownsString(const char* s) const {
+    return s >= strings_ && s < strings_ + stringsSize_;
+  }
+
+  bool ownsSlot(const VariantSlot* slot) const {
+    return slot >= slots_ && slot < slots_ + slotCount_;
+  }
+
+  void slideStrings() {
+    char* dst = strings_;
+    size_t i = 0;
+    while (i < stringsSize_) {
+      if (!liveStrings_.test(i)) {
+        i++;
+        continue;
+      }
+      size_t begin = i;
+      while (i < stringsSize_ && liveStrings_.test(i))
+        i++;
+      memmove(dst, strings_ + begin, i - begin);
+      dst += i - begin;
+    }
+  }
+
+  void slideSlots() {
+    size_t dst = slotCount_;
+    for (size_t i = slotCount_; i > 0; i--) {
+      if (liveSlots_.test(i - 1) && --dst != i - 1)
+        slots_[dst] = slots_[i - 1];
+    }
+  }
+
+  MemoryPool* pool_;
+  char* strings_;
+  size_t stringsSize_;
+  VariantSlot* slots_;
+  size_t slotCount_;
+  RankedBitmap liveStrings_;
+  RankedBitmap liveSlots_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
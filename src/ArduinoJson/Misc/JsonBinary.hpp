@@ -0,0 +1,86 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint8_t
+#include <string.h>  // for memcmp
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// A binary value.
+// serializeMsgPack() writes it as bin, or as ext if it has an extension type;
+// serializeJson() writes it as a base64 string.
+class JsonBinary {
+ public:
+  JsonBinary() : data_(0), size_(0), type_(0), isExt_(false) {}
+
+  // A bin value
+  JsonBinary(const void* data, size_t size)
+      : data_(reinterpret_cast<const uint8_t*>(data)),
+        size_(size),
+        type_(0),
+        isExt_(false) {}
+
+  // An ext value
+  JsonBinary(int8_t extType, const void* data, size_t size)
+      : data_(reinterpret_cast<const uint8_t*>(data)),
+        size_(size),
+        type_(extType),
+        isExt_(true) {}
+
+  // Returns a pointer to the bytes.
+  const uint8_t* data() const {
+    return data_;
+  }
+
+  // Returns the number of bytes.
+  size_t size() const {
+    return size_;
+  }
+
+  // Returns true if the value is an ext.
+  bool isExt() const {
+    return isExt_;
+  }
+
+  // Returns the extension type, or 0 if the value is a bin.
+  int8_t extType() const {
+    return type_;
+  }
+
+  // Returns true if the value is null.
+  bool isNull() const {
+    return !data_;
+  }
+
+  // Returns true if the value is non-null.
+  explicit operator bool() const {
+    return data_ != 0;
+  }
+
+  // Returns true if the values have the same type and bytes.
+  friend bool operator==(JsonBinary lhs, JsonBinary rhs) {
+    if (lhs.size_ != rhs.size_ || lhs.isExt_ != rhs.isExt_ ||
+        lhs.type_ != rhs.type_ || !lhs.data_ != !rhs.data_)
+      return false;
+    return lhs.size_ == 0 || memcmp(lhs.data_, rhs.data_, lhs.size_) == 0;
+  }
+
+  // Returns true if the values differ.
+  friend bool operator!=(JsonBinary lhs, JsonBinary rhs) {
+    return !(lhs == rhs);
+  }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  int8_t type_;
+  bool isExt_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,108 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stddef.h>  // size_t
+#include <string.h>  // strcmp, strlen
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// A list of object keys shared by the producer and the consumer of documents.
+// serializeMsgPack() replaces the keys found in the list with their index,
+// and deserializeMsgPack() replaces the indexes with pointers to the keys.
+// deserializeJson(), deserializeMsgPack(), and deserializeCbor() also link
+// the string keys found in the list instead of copying them, so documents
+// parsed with the same dictionary share the keys.
+// The dictionary doesn't copy the list: the list and the keys must remain
+// alive as long as the dictionary and the documents use them. It never
+// modifies them, so threads can share it.
+// A list sorted in strcmp() order is searched by bisection, other lists
+// sequentially.
+class KeyDictionary {
+ public:
+  KeyDictionary() : keys_(0), size_(0), sorted_(true) {}
+
+  KeyDictionary(const char* const* keys, size_t size)
+      : keys_(keys), size_(size), sorted_(isSorted(keys, size)) {}
+
+  template <size_t N>
+  KeyDictionary(const char* const (&keys)[N])
+      : keys_(keys), size_(N), sorted_(isSorted(keys, N)) {}
+
+  // Returns the number of keys.
+  size_t size() const {
+    return size_;
+  }
+
+  // Returns the key with the specified index, or null if out of range.
+  const char* operator[](size_t index) const {
+    return index < size_ ? keys_[index] : 0;
+  }
+
+  // Returns the index of the key, or size() if it's not in the dictionary.
+  size_t indexOf(const char* key) const {
+    if (!key)
+      return size_;
+    return search(key, strlen(key));
+  }
+
+  // Returns the key equal to the n characters at s, or null if it's not in
+  // the dictionary.
+  const char* find(const char* s, size_t n) const {
+    return (*this)[search(s, n)];
+  }
+
+ private:
+  static bool isSorted(const char* const* keys, size_t size) {
+    for (size_t i = 1; i < size; i++) {
+      if (strcmp(keys[i - 1], keys[i]) >= 0)
+        return false;
+    }
+    return true;
+  }
+
+  // Compares a key with the n characters at s, like strcmp()
+  static int compare(const char* key, const char* s, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+      if (!key[i])
+        return -1;
+      if (key[i] != s[i])
+        return static_cast<unsigned char>(key[i]) -
+               static_cast<unsigned char>(s[i]);
+    }
+    return key[n] ? 1 : 0;
+  }
+
+  size_t search(const char* s, size_t n) const {
+    if (!sorted_) {
+      for (size_t i = 0; i < size_; i++) {
+        // keys from a document deserialized with this dictionary are linked
+        if (keys_[i] == s || compare(keys_[i], s, n) == 0)
+          return i;
+      }
+      return size_;
+    }
+    size_t low = 0, high = size_;
+    while (low < high) {
+      size_t middle = low + (high - low) / 2;
+      int result = compare(keys_[middle], s, n);
+      if (result == 0)
+        return middle;
+      if (result < 0)
+        low = middle + 1;
+      else
+        high = middle;
+    }
+    return size_;
+  }
+
+  const char* const* keys_;
+  size_t size_;
+  bool sorted_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -31,6 +31,23 @@ class MsgPackDeserializer {
     return foundSomething_ ? err : DeserializationError::EmptyInput;
   }
 
+  // see KeyDictionary
+  void setKeyDictionary(KeyDictionary keys) {
+    keys_ = keys;
+  }
+
+  // Writes the value to a serializer that doesn't need the number of elements
+  // up front, like JsonSerializer.
+  // The pool only holds the current string; it's cleared after each value.
+  template <typename TSerializer>
+  DeserializationError transcode(
+      TSerializer& serializer,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+    err = transcodeVariant(serializer, nestingLimit);
+    return foundSomething_ ? err : DeserializationError::EmptyInput;
+  }
+
  private:
   template <typename TFilter>
   DeserializationError::Code parseVariant(
@@ -45,6 +62,13 @@ class MsgPackDeserializer {
 
     foundSomething_ = true;
 
+    return parseVariant(code, variant, filter, nestingLimit);
+  }
+
+  template <typename TFilter>
+  DeserializationError::Code parseVariant(
+      uint8_t code, VariantData* variant, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
     bool allowValue = filter.allowValue();
 
     if (allowValue) {
@@ -54,7 +78,9 @@ class MsgPackDeserializer {
 
     switch (code) {
       case 0xc0:
-        // already null
+        // usually null already, except when merging
+        if (allowValue)
+          variant->setNull();
         return DeserializationError::Ok;
 
       case 0xc1:
@@ -70,23 +96,41 @@ class MsgPackDeserializer {
           variant->setBoolean(true);
         return DeserializationError::Ok;
 
-      case 0xc4:  // bin 8 (not supported)
-        return skipString<uint8_t>();
+      case 0xc4:  // bin 8
+        if (allowValue)
+          return readBinary<uint8_t>(variant);
+        else
+          return skipString<uint8_t>();
 
-      case 0xc5:  // bin 16 (not supported)
-        return skipString<uint16_t>();
+      case 0xc5:  // bin 16
+        if (allowValue)
+          return readBinary<uint16_t>(variant);
+        else
+          return skipString<uint16_t>();
 
-      case 0xc6:  // bin 32 (not supported)
-        return skipString<uint32_t>();
+      case 0xc6:  // bin 32
+        if (allowValue)
+          return readBinary<uint32_t>(variant);
+        else
+          return skipString<uint32_t>();
 
-      case 0xc7:  // ext 8 (not supported)
-        return skipExt<uint8_t>();
+      case 0xc7:  // ext 8
+        if (allowValue)
+          return readExt<uint8_t>(variant);
+        else
+          return skipExt<uint8_t>();
 
-      case 0xc8:  // ext 16 (not supported)
-        return skipExt<uint16_t>();
+      case 0xc8:  // ext 16
+        if (allowValue)
+          return readExt<uint16_t>(variant);
+        else
+          return skipExt<uint16_t>();
 
-      case 0xc9:  // ext 32 (not supported)
-        return skipExt<uint32_t>();
+      case 0xc9:  // ext 32
+        if (allowValue)
+          return readExt<uint32_t>(variant);
+        else
+          return skipExt<uint32_t>();
 
       case 0xca:
         if (allowValue)
@@ -156,20 +200,35 @@ class MsgPackDeserializer {
         return skipBytes(8);
 #endif
 
-      case 0xd4:  // fixext 1 (not supported)
-        return skipBytes(2);
+      case 0xd4:  // fixext 1
+        if (allowValue)
+          return readExt(variant, 1);
+        else
+          return skipBytes(2);
 
-      case 0xd5:  // fixext 2 (not supported)
-        return skipBytes(3);
+      case 0xd5:  // fixext 2
+        if (allowValue)
+          return readExt(variant, 2);
+        else
+          return skipBytes(3);
 
-      case 0xd6:  // fixext 4 (not supported)
-        return skipBytes(5);
+      case 0xd6:  // fixext 4
+        if (allowValue)
+          return readExt(variant, 4);
+        else
+          return skipBytes(5);
 
-      case 0xd7:  // fixext 8 (not supported)
-        return skipBytes(9);
+      case 0xd7:  // fixext 8
+        if (allowValue)
+          return readExt(variant, 8);
+        else
+          return skipBytes(9);
 
-      case 0xd8:  // fixext 16 (not supported)
-        return skipBytes(17);
+      case 0xd8:  // fixext 16
+        if (allowValue)
+          return readExt(variant, 16);
+        else
+          return skipBytes(17);
 
       case 0xd9:
         if (allowValue)
@@ -243,10 +302,8 @@ class MsgPackDeserializer {
   }
 
   DeserializationError::Code skipBytes(size_t n) {
-    for (; n; --n) {
-      if (reader_.read() < 0)
-        return DeserializationError::IncompleteInput;
-    }
+    if (skipInput(reader_, n) < n)
+      return DeserializationError::IncompleteInput;
     return DeserializationError::Ok;
   }
 
@@ -266,6 +323,8 @@ class MsgPackDeserializer {
   template <typename T>
   DeserializationError::Code readInteger(VariantData* variant) {
     DeserializationError::Code err;
+    StatsTimer<TStringStorage> timer(stringStorage_,
+                                     &DeserializationStats::numberTime);
     T value;
 
     err = readInteger(value);
@@ -281,6 +340,8 @@ class MsgPackDeserializer {
   typename enable_if<sizeof(T) == 4, DeserializationError::Code>::type
   readFloat(VariantData* variant) {
     DeserializationError::Code err;
+    StatsTimer<TStringStorage> timer(stringStorage_,
+                                     &DeserializationStats::numberTime);
     T value;
 
     err = readBytes(value);
@@ -297,6 +358,8 @@ class MsgPackDeserializer {
   typename enable_if<sizeof(T) == 8, DeserializationError::Code>::type
   readDouble(VariantData* variant) {
     DeserializationError::Code err;
+    StatsTimer<TStringStorage> timer(stringStorage_,
+                                     &DeserializationStats::numberTime);
     T value;
 
     err = readBytes(value);
@@ -313,6 +376,8 @@ class MsgPackDeserializer {
   typename enable_if<sizeof(T) == 4, DeserializationError::Code>::type
   readDouble(VariantData* variant) {
     DeserializationError::Code err;
+    StatsTimer<TStringStorage> timer(stringStorage_,
+                                     &DeserializationStats::numberTime);
     uint8_t i[8];  // input is 8 bytes
     T value;       // output is 4 bytes
     uint8_t* o = reinterpret_cast<uint8_t*>(&value);
@@ -367,31 +432,93 @@ class MsgPackDeserializer {
   DeserializationError::Code readString(VariantData* variant, size_t n) {
     DeserializationError::Code err;
 
+    // see DeserializationOption::ZeroCopy
+    const char* s = n ? readInPlace(reader_, n) : 0;
+    if (s) {
+      variant->setUnterminatedString(s, n);
+      return DeserializationError::Ok;
+    }
+
     err = readString(n);
     if (err)
       return err;
 
-    variant->setString(stringStorage_.save());
+    variant->setString(stringStorage_);
     return DeserializationError::Ok;
   }
 
   DeserializationError::Code readString(size_t n) {
-    DeserializationError::Code err;
+    StatsTimer<TStringStorage> timer(stringStorage_,
+                                     &DeserializationStats::stringTime);
 
     stringStorage_.startString();
-    for (; n; --n) {
-      uint8_t c;
+    if (!stringStorage_.appendFrom(reader_, n))
+      return DeserializationError::IncompleteInput;
 
-      err = readBytes(c);
-      if (err)
-        return err;
+    if (!stringStorage_.isValid())
+      return DeserializationError::NoMemory;
+
+    return DeserializationError::Ok;
+  }
 
-      stringStorage_.append(static_cast<char>(c));
+  template <typename T>
+  DeserializationError::Code readBinary(VariantData* variant) {
+    DeserializationError::Code err;
+    T size;
+
+    err = readInteger(size);
+    if (err)
+      return err;
+
+    return readBinary(variant, size);
+  }
+
+  DeserializationError::Code readBinary(VariantData* variant, size_t n) {
+    DeserializationError::Code err;
+
+    // see DeserializationOption::ZeroCopy
+    const char* s = n ? readInPlace(reader_, n) : 0;
+    if (s) {
+      variant->setBinary(JsonString(s, n, JsonString::Linked));
+      return DeserializationError::Ok;
     }
 
-    if (!stringStorage_.isValid())
-      return DeserializationError::NoMemory;
+    err = readString(n);
+    if (err)
+      return err;
+
+    variant->setBinary(stringStorage_.save());
+    return DeserializationError::Ok;
+  }
+
+  template <typename T>
+  DeserializationError::Code readExt(VariantData* variant) {
+    DeserializationError::Code err;
+    T size;
+
+    err = readInteger(size);
+    if (err)
+      return err;
+
+    return readExt(variant, size);
+  }
+
+  // Stores the extension type followed by the n bytes of data
+  DeserializationError::Code readExt(VariantData* variant, size_t n) {
+    DeserializationError::Code err;
+
+    // see DeserializationOption::ZeroCopy
+    const char* s = readInPlace(reader_, n + 1);
+    if (s) {
+      variant->setExt(JsonString(s, n + 1, JsonString::Linked));
+      return DeserializationError::Ok;
+    }
 
+    err = readString(n + 1);
+    if (err)
+      return err;
+
+    variant->setExt(stringStorage_.save());
     return DeserializationError::Ok;
   }
 
@@ -430,21 +557,29 @@ class MsgPackDeserializer {
 
     TFilter memberFilter = filter[0U];
 
-    for (; n; --n) {
-      VariantData* value;
+    // Reserve all the slots at once, so we fail before reading the elements
+    VariantSlot* slot = 0;
+    if (memberFilter.allow() && n) {
+      ARDUINOJSON_ASSERT(array != 0);
+      slot = array->addSlots(n, pool_);
+      if (!slot)
+        return DeserializationError::NoMemory;
+    }
 
-      if (memberFilter.allow()) {
-        ARDUINOJSON_ASSERT(array != 0);
-        value = array->addElement(pool_);
-        if (!value)
-          return DeserializationError::NoMemory;
-      } else {
-        value = 0;
-      }
+    for (; n; --n) {
+      VariantData* value = slot ? slot->data() : 0;
 
+      SkipCounter<TStringStorage> counter(stringStorage_,
+                                          allowArray && !value, 0);
       err = parseVariant(value, memberFilter, nestingLimit.decrement());
-      if (err)
+      if (err) {
+        if (slot)
+          array->removeSlotsAfter(slot, pool_);
         return err;
+      }
+
+      if (slot)
+        slot = slot->next();
     }
 
     return DeserializationError::Ok;
@@ -468,7 +603,7 @@ class MsgPackDeserializer {
   DeserializationError::Code readObject(
       VariantData* variant, size_t n, TFilter filter,
       DeserializationOption::NestingLimit nestingLimit) {
-    DeserializationError::Code err;
+    DeserializationError::Code err = DeserializationError::Ok;
 
     if (nestingLimit.reached())
       return DeserializationError::TooDeep;
@@ -476,47 +611,207 @@ class MsgPackDeserializer {
     CollectionData* object;
     if (filter.allowObject()) {
       ARDUINOJSON_ASSERT(variant != 0);
-      object = &variant->toObject();
+      // merge with the existing members, if any
+      object = variant->isObject() ? variant->asObject() : &variant->toObject();
     } else {
       object = 0;
     }
 
+    // look for existing members only when merging
+    bool merge = object && object->head();
+
+    // When all members are allowed, reserve all the slots at once, so we fail
+    // before reading the members
+    VariantSlot* reserved = 0;
+    if (object && !merge && n && allowsAllMembers(filter)) {
+      reserved = object->addSlots(n, pool_);
+      if (!reserved)
+        return DeserializationError::NoMemory;
+    }
+    VariantSlot* lastUsed = 0;
+
     for (; n; --n) {
-      err = readKey();
+      JsonString key;
+      err = readKey(key);
       if (err)
-        return err;
+        break;
 
-      JsonString key = stringStorage_.str();
       TFilter memberFilter = filter[key.c_str()];
       VariantData* member;
 
-      if (memberFilter.allow()) {
+      if (reserved) {
+        JsonString savedKey = key.isLinked() ? key : stringStorage_.save();
+        if (!reserved->setKey(savedKey, pool_)) {
+          err = DeserializationError::NoMemory;
+          break;
+        }
+        lastUsed = reserved;
+        reserved = reserved->next();
+        member = lastUsed->data();
+      } else if (memberFilter.allow()) {
         ARDUINOJSON_ASSERT(object != 0);
 
-        // Save key in memory pool.
-        // This MUST be done before adding the slot.
-        key = stringStorage_.save();
+        member = merge ? object->getMember(adaptString(key.c_str())) : 0;
+        if (!member) {
+          // Save key in memory pool, unless it's from the dictionary.
+          // This MUST be done before adding the slot.
+          if (!key.isLinked())
+            key = stringStorage_.save();
 
-        VariantSlot* slot = object->addSlot(pool_);
-        if (!slot)
-          return DeserializationError::NoMemory;
+          VariantSlot* slot = object->addSlot(pool_);
+          if (!slot)
+            return DeserializationError::NoMemory;
 
-        slot->setKey(key);
+          if (!slot->setKey(key, pool_)) {
+            object->removeSlot(slot, pool_);
+            return DeserializationError::NoMemory;
+          }
 
-        member = slot->data();
+          member = slot->data();
+        }
       } else {
         member = 0;
       }
 
+      SkipCounter<TStringStorage> counter(stringStorage_, object && !member, 0);
       err = parseVariant(member, memberFilter, nestingLimit.decrement());
+      if (err)
+        break;
+    }
+
+    // remove the reserved slots that don't have a key
+    if (err && reserved)
+      object->removeSlotsAfter(lastUsed, pool_);
+
+    return err;
+  }
+
+  template <typename TSerializer>
+  DeserializationError::Code transcodeVariant(
+      TSerializer& serializer,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    uint8_t code = 0;
+    err = readByte(code);
+    if (err)
+      return err;
+
+    foundSomething_ = true;
+
+    switch (code) {
+      case 0xdc:
+        return transcodeArray<uint16_t>(serializer, nestingLimit);
+
+      case 0xdd:
+        return transcodeArray<uint32_t>(serializer, nestingLimit);
+
+      case 0xde:
+        return transcodeObject<uint16_t>(serializer, nestingLimit);
+
+      case 0xdf:
+        return transcodeObject<uint32_t>(serializer, nestingLimit);
+    }
+
+    switch (code & 0xf0) {
+      case 0x80:
+        return transcodeObject(serializer, code & 0x0F, nestingLimit);
+
+      case 0x90:
+        return transcodeArray(serializer, code & 0x0F, nestingLimit);
+    }
+
+    VariantData value;
+    err = parseVariant(code, &value, AllowAllFilter(), nestingLimit);
+    if (err)
+      return err;
+    value.accept(serializer);
+    pool_->clear();
+    return DeserializationError::Ok;
+  }
+
+  template <typename TSize, typename TSerializer>
+  DeserializationError::Code transcodeArray(
+      TSerializer& serializer,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+    TSize size;
+
+    err = readInteger(size);
+    if (err)
+      return err;
+
+    return transcodeArray(serializer, size, nestingLimit);
+  }
+
+  template <typename TSerializer>
+  DeserializationError::Code transcodeArray(
+      TSerializer& serializer, size_t n,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    serializer.beginArray();
+    for (size_t i = 0; i < n; i++) {
+      if (i > 0)
+        serializer.writeComma();
+      err = transcodeVariant(serializer, nestingLimit.decrement());
       if (err)
         return err;
     }
+    serializer.endArray();
 
     return DeserializationError::Ok;
   }
 
-  DeserializationError::Code readKey() {
+  template <typename TSize, typename TSerializer>
+  DeserializationError::Code transcodeObject(
+      TSerializer& serializer,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+    TSize size;
+
+    err = readInteger(size);
+    if (err)
+      return err;
+
+    return transcodeObject(serializer, size, nestingLimit);
+  }
+
+  template <typename TSerializer>
+  DeserializationError::Code transcodeObject(
+      TSerializer& serializer, size_t n,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    serializer.beginObject();
+    for (size_t i = 0; i < n; i++) {
+      if (i > 0)
+        serializer.writeComma();
+
+      JsonString key;
+      err = readKey(key);
+      if (err)
+        return err;
+      serializer.writeKey(key.c_str(), key.size());
+
+      err = transcodeVariant(serializer, nestingLimit.decrement());
+      if (err)
+        return err;
+    }
+    serializer.endObject();
+
+    return DeserializationError::Ok;
+  }
+
+  // Reads a string key into the string storage, or the index of a key in the
+  // dictionary
+  DeserializationError::Code readKey(JsonString& key) {
     DeserializationError::Code err;
     uint8_t code;
 
@@ -524,22 +819,66 @@ class MsgPackDeserializer {
     if (err)
       return err;
 
-    if ((code & 0xe0) == 0xa0)
-      return readString(code & 0x1f);
+    if (code <= 0x7f)
+      return lookupKey(code, key);
 
-    switch (code) {
-      case 0xd9:
-        return readString<uint8_t>();
+    if ((code & 0xe0) == 0xa0) {
+      err = readString(code & 0x1f);
+    } else {
+      switch (code) {
+        case 0xcc:
+          return lookupKey<uint8_t>(key);
 
-      case 0xda:
-        return readString<uint16_t>();
+        case 0xcd:
+          return lookupKey<uint16_t>(key);
 
-      case 0xdb:
-        return readString<uint32_t>();
+        case 0xd9:
+          err = readString<uint8_t>();
+          break;
 
-      default:
-        return DeserializationError::InvalidInput;
+        case 0xda:
+          err = readString<uint16_t>();
+          break;
+
+        case 0xdb:
+          err = readString<uint32_t>();
+          break;
+
+        default:
+          return DeserializationError::InvalidInput;
+      }
     }
+    if (err)
+      return err;
+
+    // not saved yet, even with StringMover; only dictionary keys are linked
+    JsonString s = stringStorage_.str();
+    const char* linked = keys_.find(s.c_str(), s.size());
+    if (linked)
+      key = JsonString(linked, JsonString::Linked);
+    else
+      key = JsonString(s.c_str(), s.size(), JsonString::Copied);
+    return DeserializationError::Ok;
+  }
+
+  template <typename T>
+  DeserializationError::Code lookupKey(JsonString& key) {
+    DeserializationError::Code err;
+    T index;
+
+    err = readInteger(index);
+    if (err)
+      return err;
+
+    return lookupKey(index, key);
+  }
+
+  DeserializationError::Code lookupKey(size_t index, JsonString& key) {
+    const char* s = keys_[index];
+    if (!s)  // also when there is no dictionary
+      return DeserializationError::InvalidInput;
+    key = JsonString(s, JsonString::Linked);
+    return DeserializationError::Ok;
   }
 
   template <typename T>
@@ -558,6 +897,7 @@ class MsgPackDeserializer {
   TReader reader_;
   TStringStorage stringStorage_;
   bool foundSomething_;
+  KeyDictionary keys_;
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -582,4 +922,25 @@ DeserializationError deserializeMsgPack(JsonDocument& doc, TChar* input,
                                           detail::forward<Args>(args)...);
 }
 
+// Parses a MessagePack input into a variant of an existing document.
+// The document isn't cleared; objects are merged with the existing members.
+template <typename TVariant, typename... Args>
+typename detail::enable_if<detail::IsVariant<TVariant>::value,
+                           DeserializationError>::type
+deserializeMsgPack(const TVariant& dst, Args&&... args) {
+  using namespace detail;
+  return deserialize<MsgPackDeserializer>(dst, detail::forward<Args>(args)...);
+}
+
+// Parses a MessagePack input into a variant of an existing document.
+// The document isn't cleared; objects are merged with the existing members.
+template <typename TVariant, typename TChar, typename... Args>
+typename detail::enable_if<detail::IsVariant<TVariant>::value,
+                           DeserializationError>::type
+deserializeMsgPack(const TVariant& dst, TChar* input, Args&&... args) {
+  using namespace detail;
+  return deserialize<MsgPackDeserializer>(dst, input,
+                                          detail::forward<Args>(args)...);
+}
+
 ARDUINOJSON_END_PUBLIC_NAMESPACE
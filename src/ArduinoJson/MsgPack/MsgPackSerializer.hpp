@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <ArduinoJson/Misc/KeyDictionary.hpp>
 #include <ArduinoJson/MsgPack/endianess.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
@@ -19,7 +20,8 @@ class MsgPackSerializer : public Visitor<size_t> {
  public:
   static const bool producesText = false;
 
-  MsgPackSerializer(TWriter writer) : writer_(writer) {}
+  MsgPackSerializer(TWriter writer, KeyDictionary keys = KeyDictionary())
+      : writer_(writer), keys_(keys) {}
 
   template <typename T>
   typename enable_if<sizeof(T) == 4, size_t>::type visitFloat(T value32) {
@@ -45,7 +47,24 @@ class MsgPackSerializer : public Visitor<size_t> {
   }
 
   size_t visitArray(const CollectionData& array) {
-    size_t n = array.size();
+    writeArrayHeader(array.size());
+    for (const VariantSlot* slot = array.head(); slot; slot = slot->next()) {
+      slot->data()->accept(*this);
+    }
+    return bytesWritten();
+  }
+
+  size_t visitObject(const CollectionData& object) {
+    writeMapHeader(object.size());
+    for (const VariantSlot* slot = object.head(); slot; slot = slot->next()) {
+      writeKey(slot->key());
+      slot->data()->accept(*this);
+    }
+    return bytesWritten();
+  }
+
+  // Writes the header of an array of n elements, which the caller writes next
+  void writeArrayHeader(size_t n) {
     if (n < 0x10) {
       writeByte(uint8_t(0x90 + n));
     } else if (n < 0x10000) {
@@ -55,14 +74,10 @@ class MsgPackSerializer : public Visitor<size_t> {
       writeByte(0xDD);
       writeInteger(uint32_t(n));
     }
-    for (const VariantSlot* slot = array.head(); slot; slot = slot->next()) {
-      slot->data()->accept(*this);
-    }
-    return bytesWritten();
   }
 
-  size_t visitObject(const CollectionData& object) {
-    size_t n = object.size();
+  // Writes the header of a map of n members, which the caller writes next
+  void writeMapHeader(size_t n) {
     if (n < 0x10) {
       writeByte(uint8_t(0x80 + n));
     } else if (n < 0x10000) {
@@ -72,11 +87,19 @@ class MsgPackSerializer : public Visitor<size_t> {
       writeByte(0xDF);
       writeInteger(uint32_t(n));
     }
-    for (const VariantSlot* slot = object.head(); slot; slot = slot->next()) {
-      visitString(slot->key());
-      slot->data()->accept(*this);
-    }
-    return bytesWritten();
+  }
+
+  void writeKey(const char* key, size_t n) {
+    visitString(key, n);
+  }
+
+  // Writes the index of the key if it's in the dictionary, the key otherwise
+  void writeKey(const char* key) {
+    size_t index = keys_.indexOf(key);
+    if (index < keys_.size())
+      visitUnsignedInteger(JsonUInt(index));
+    else
+      visitString(key);
   }
 
   size_t visitString(const char* value) {
@@ -102,6 +125,37 @@ class MsgPackSerializer : public Visitor<size_t> {
     return bytesWritten();
   }
 
+  size_t visitBinary(JsonBinary value) {
+    size_t n = value.size();
+    if (value.isExt()) {
+      switch (n) {
+        case 1:
+          writeByte(0xD4);
+          break;
+        case 2:
+          writeByte(0xD5);
+          break;
+        case 4:
+          writeByte(0xD6);
+          break;
+        case 8:
+          writeByte(0xD7);
+          break;
+        case 16:
+          writeByte(0xD8);
+          break;
+        default:
+          writeSize(0xC7, n);
+          break;
+      }
+      writeInteger(value.extType());
+    } else {
+      writeSize(0xC4, n);
+    }
+    writeBytes(value.data(), n);
+    return bytesWritten();
+  }
+
   size_t visitRawJson(const char* data, size_t size) {
     writeBytes(reinterpret_cast<const uint8_t*>(data), size);
     return bytesWritten();
@@ -188,6 +242,20 @@ class MsgPackSerializer : public Visitor<size_t> {
     writer_.write(p, n);
   }
 
+  // Writes the code for 8, 16, or 32 bits, followed by the size
+  void writeSize(uint8_t code8, size_t n) {
+    if (n < 0x100) {
+      writeByte(code8);
+      writeInteger(uint8_t(n));
+    } else if (n < 0x10000) {
+      writeByte(uint8_t(code8 + 1));
+      writeInteger(uint16_t(n));
+    } else {
+      writeByte(uint8_t(code8 + 2));
+      writeInteger(uint32_t(n));
+    }
+  }
+
   template <typename T>
   void writeInteger(T value) {
     fixEndianess(value);
@@ -195,8 +263,27 @@ class MsgPackSerializer : public Visitor<size_t> {
   }
 
   CountingDecorator<TWriter> writer_;
+  KeyDictionary keys_;
 };
 
+// Adds the keys of the objects in the variant to the list, unless they're
+// already in it. Returns the new size of the list.
+inline size_t learnKeys(const VariantData* variant, const char** keys,
+                        size_t size, size_t capacity) {
+  const CollectionData* collection = variant ? variant->asCollection() : 0;
+  if (!collection)
+    return size;
+  bool isObject = variant->isObject();
+  for (const VariantSlot* slot = collection->head(); slot;
+       slot = slot->next()) {
+    if (isObject && size < capacity &&
+        KeyDictionary(keys, size).indexOf(slot->key()) == size)
+      keys[size++] = slot->key();
+    size = learnKeys(slot->data(), keys, size, capacity);
+  }
+  return size;
+}
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
 
 ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
@@ -224,4 +311,43 @@ inline size_t measureMsgPack(JsonVariantConst source) {
   return measure<MsgPackSerializer>(source);
 }
 
+// Produces a MessagePack document, replacing the keys found in the dictionary
+// with their index.
+template <typename TDestination>
+inline size_t serializeMsgPack(JsonVariantConst source, TDestination& output,
+                               KeyDictionary keys) {
+  using namespace ArduinoJson::detail;
+  Writer<TDestination> writer(output);
+  MsgPackSerializer<Writer<TDestination>> serializer(writer, keys);
+  return variantAccept(VariantAttorney::getData(source), serializer);
+}
+
+// Produces a MessagePack document, replacing the keys found in the dictionary
+// with their index.
+inline size_t serializeMsgPack(JsonVariantConst source, void* output,
+                               size_t size, KeyDictionary keys) {
+  using namespace ArduinoJson::detail;
+  StaticStringWriter writer(reinterpret_cast<char*>(output), size);
+  MsgPackSerializer<StaticStringWriter> serializer(writer, keys);
+  return variantAccept(VariantAttorney::getData(source), serializer);
+}
+
+// Computes the length of the document that serializeMsgPack() produces with
+// the dictionary.
+inline size_t measureMsgPack(JsonVariantConst source, KeyDictionary keys) {
+  using namespace ArduinoJson::detail;
+  DummyWriter writer;
+  MsgPackSerializer<DummyWriter> serializer(writer, keys);
+  return variantAccept(VariantAttorney::getData(source), serializer);
+}
+
+// Fills the list with the distinct keys of the objects in the sample, up to
+// the capacity, and returns the number of keys. The list points to the keys
+// in the sample, which must remain alive as long as the list is used.
+inline size_t learnKeys(JsonVariantConst sample, const char** keys,
+                        size_t capacity) {
+  using namespace ArduinoJson::detail;
+  return learnKeys(VariantAttorney::getData(sample), keys, 0, capacity);
+}
+
 ARDUINOJSON_END_PUBLIC_NAMESPACE
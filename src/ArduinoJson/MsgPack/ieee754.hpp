@@ -6,6 +6,8 @@
 
 #include <ArduinoJson/Namespace.hpp>
 
+#include <stdint.h>  // uint16_t, uint32_t
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 inline void doubleToFloat(const uint8_t d[8], uint8_t f[4]) {
@@ -15,4 +17,58 @@ inline void doubleToFloat(const uint8_t d[8], uint8_t f[4]) {
   f[3] = uint8_t((d[3] << 3) | (d[4] >> 5));
 }
 
+// Converts the bits of a binary16 to the bits of a binary32
+inline uint32_t halfToFloat(uint16_t h) {
+  uint32_t sign = uint32_t(h & 0x8000) << 16;
+  uint32_t exponent = (h >> 10) & 0x1f;
+  uint32_t mantissa = h & 0x3ff;
+  if (exponent == 0x1f)  // infinity or NaN
+    return sign | 0x7f800000 | (mantissa << 13);
+  if (exponent == 0) {
+    if (mantissa == 0)  // zero
+      return sign;
+    // subnormal: normalize the mantissa
+    exponent = 1;
+    while (!(mantissa & 0x400)) {
+      mantissa <<= 1;
+      exponent--;
+    }
+    mantissa &= 0x3ff;
+  }
+  return sign | ((exponent + 112) << 23) | (mantissa << 13);
+}
+
+// Converts the bits of a binary32 to the bits of a binary16.
+// Returns false if the value can't be represented exactly.
+inline bool floatToHalf(uint32_t f, uint16_t& h) {
+  uint16_t sign = uint16_t((f >> 16) & 0x8000);
+  int32_t exponent = int32_t((f >> 23) & 0xff) - 127;
+  uint32_t mantissa = f & 0x7fffff;
+  if (exponent == 128) {  // infinity or NaN
+    if (mantissa & 0x1fff)
+      return false;
+    h = uint16_t(sign | 0x7c00 | (mantissa >> 13));
+    return true;
+  }
+  if (exponent == -127 && mantissa == 0) {  // zero
+    h = sign;
+    return true;
+  }
+  if (exponent > 15 || exponent < -24)
+    return false;
+  if (exponent >= -14) {  // normal
+    if (mantissa & 0x1fff)
+      return false;
+    h = uint16_t(sign | uint32_t(exponent + 15) << 10 | (mantissa >> 13));
+    return true;
+  }
+  // subnormal: the implicit bit becomes explicit
+  mantissa |= 0x800000;
+  uint32_t shift = uint32_t(13 - 14 - exponent);
+  if (mantissa & ((uint32_t(1) << shift) - 1))
+    return false;
+  h = uint16_t(sign | (mantissa >> shift));
+  return true;
+}
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
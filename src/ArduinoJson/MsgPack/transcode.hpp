@@ -0,0 +1,128 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/StaticJsonDocument.hpp>
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+#include <ArduinoJson/Json/JsonSerializer.hpp>
+#include <ArduinoJson/MsgPack/MsgPackDeserializer.hpp>
+#include <ArduinoJson/MsgPack/MsgPackSerializer.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+template <typename TReader, typename TStringStorage, typename TWriter>
+DeserializationError transcodeJsonToMsgPack(
+    MemoryPool* pool, TReader reader, TStringStorage stringStorage,
+    TWriter writer, DeserializationOption::NestingLimit nestingLimit) {
+  static_assert(IsInMemoryReader<TReader>::value,
+                "transcodeJsonToMsgPack() requires an input in memory");
+  MsgPackSerializer<TWriter> serializer(writer);
+  return makeDeserializer<JsonDeserializer>(pool, reader, stringStorage)
+      .transcode(serializer, nestingLimit);
+}
+
+template <typename TReader, typename TStringStorage, typename TWriter>
+DeserializationError transcodeMsgPackToJson(
+    MemoryPool* pool, TReader reader, TStringStorage stringStorage,
+    TWriter writer, DeserializationOption::NestingLimit nestingLimit) {
+  JsonSerializer<TWriter> serializer(writer);
+  return makeDeserializer<MsgPackDeserializer>(pool, reader, stringStorage)
+      .transcode(serializer, nestingLimit);
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Converts a JSON document to MessagePack without building a JsonDocument.
+// The memory usage depends on the nesting and the longest string, which must
+// fit in ARDUINOJSON_TRANSCODING_BUFFER_SIZE (unless the input is mutable).
+// The input must be in memory (e.g. const char*, std::string) because each
+// array and object is scanned ahead to count its elements. Since every level
+// scans its content again, the time grows with the input size multiplied by
+// the nesting depth.
+template <typename TInput, typename TDestination>
+DeserializationError transcodeJsonToMsgPack(
+    TInput&& input, TDestination& output,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  StaticJsonDocument<ARDUINOJSON_TRANSCODING_BUFFER_SIZE> buffer;
+  MemoryPool* pool = VariantAttorney::getPool(buffer);
+  return transcodeJsonToMsgPack(
+      pool, makeReader(detail::forward<TInput>(input)),
+      makeStringStorage(input, pool), Writer<TDestination>(output),
+      nestingLimit);
+}
+
+// Converts a JSON document to MessagePack without building a JsonDocument.
+template <typename TChar, typename TDestination>
+DeserializationError transcodeJsonToMsgPack(
+    TChar* input, TDestination& output,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  StaticJsonDocument<ARDUINOJSON_TRANSCODING_BUFFER_SIZE> buffer;
+  MemoryPool* pool = VariantAttorney::getPool(buffer);
+  return transcodeJsonToMsgPack(pool, makeReader(input),
+                                makeStringStorage(input, pool),
+                                Writer<TDestination>(output), nestingLimit);
+}
+
+// Converts a JSON document to MessagePack without building a JsonDocument.
+template <typename TChar, typename TDestination>
+DeserializationError transcodeJsonToMsgPack(
+    TChar* input, size_t inputSize, TDestination& output,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  StaticJsonDocument<ARDUINOJSON_TRANSCODING_BUFFER_SIZE> buffer;
+  MemoryPool* pool = VariantAttorney::getPool(buffer);
+  return transcodeJsonToMsgPack(pool, makeReader(input, inputSize),
+                                makeStringStorage(input, pool),
+                                Writer<TDestination>(output), nestingLimit);
+}
+
+// Converts a MessagePack document to JSON without building a JsonDocument.
+// The memory usage depends on the nesting and the longest string, which must
+// fit in ARDUINOJSON_TRANSCODING_BUFFER_SIZE (unless the input is mutable).
+// The input can be a stream.
+template <typename TInput, typename TDestination>
+DeserializationError transcodeMsgPackToJson(
+    TInput&& input, TDestination& output,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  StaticJsonDocument<ARDUINOJSON_TRANSCODING_BUFFER_SIZE> buffer;
+  MemoryPool* pool = VariantAttorney::getPool(buffer);
+  return transcodeMsgPackToJson(
+      pool, makeReader(detail::forward<TInput>(input)),
+      makeStringStorage(input, pool), Writer<TDestination>(output),
+      nestingLimit);
+}
+
+// Converts a MessagePack document to JSON without building a JsonDocument.
+template <typename TChar, typename TDestination>
+DeserializationError transcodeMsgPackToJson(
+    TChar* input, TDestination& output,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  StaticJsonDocument<ARDUINOJSON_TRANSCODING_BUFFER_SIZE> buffer;
+  MemoryPool* pool = VariantAttorney::getPool(buffer);
+  return transcodeMsgPackToJson(pool, makeReader(input),
+                                makeStringStorage(input, pool),
+                                Writer<TDestination>(output), nestingLimit);
+}
+
+// Converts a MessagePack document to JSON without building a JsonDocument.
+template <typename TChar, typename TDestination>
+DeserializationError transcodeMsgPackToJson(
+    TChar* input, size_t inputSize, TDestination& output,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  StaticJsonDocument<ARDUINOJSON_TRANSCODING_BUFFER_SIZE> buffer;
+  MemoryPool* pool = VariantAttorney::getPool(buffer);
+  return transcodeMsgPackToJson(pool, makeReader(input, inputSize),
+                                makeStringStorage(input, pool),
+                                Writer<TDestination>(output), nestingLimit);
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
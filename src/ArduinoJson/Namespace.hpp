@@ -11,7 +11,7 @@
 #ifndef ARDUINOJSON_VERSION_NAMESPACE
 
 #  define ARDUINOJSON_VERSION_NAMESPACE                                       \
-    ARDUINOJSON_CONCAT4(                                                      \
+    ARDUINOJSON_CONCAT5(                                                      \
         ARDUINOJSON_VERSION_MACRO,                                            \
         ARDUINOJSON_BIN2ALPHA(                                                \
             ARDUINOJSON_ENABLE_PROGMEM, ARDUINOJSON_USE_LONG_LONG,            \
@@ -19,7 +19,10 @@
         ARDUINOJSON_BIN2ALPHA(                                                \
             ARDUINOJSON_ENABLE_NAN, ARDUINOJSON_ENABLE_INFINITY,              \
             ARDUINOJSON_ENABLE_COMMENTS, ARDUINOJSON_DECODE_UNICODE),         \
-        ARDUINOJSON_SLOT_OFFSET_SIZE)
+        ARDUINOJSON_SLOT_OFFSET_SIZE,                                         \
+        ARDUINOJSON_BIN2ALPHA(                                                \
+            ARDUINOJSON_COMPACT_SLOTS, ARDUINOJSON_INLINE_SHORT_STRINGS,      \
+            ARDUINOJSON_STORE_KEY_SIZE, ARDUINOJSON_STORE_COLLECTION_SIZE))
 
 #endif
 
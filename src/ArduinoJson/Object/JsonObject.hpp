@@ -84,11 +84,12 @@ class JsonObject : public detail::VariantOperators<JsonObject> {
   }
 
   // Removes all the members of the object.
-  // ⚠️ Doesn't release the memory associated with the removed members.
+  // The pool reuses the memory of the removed members.
   // https://arduinojson.org/v6/api/jsonobject/clear/
   void clear() const {
     if (!data_)
       return;
+    data_->release(pool_);
     data_->clear();
   }
 
@@ -126,16 +127,16 @@ class JsonObject : public detail::VariantOperators<JsonObject> {
   }
 
   // Removes the member at the specified iterator.
-  // ⚠️ Doesn't release the memory associated with the removed member.
+  // The pool reuses the memory of the removed member.
   // https://arduinojson.org/v6/api/jsonobject/remove/
   FORCE_INLINE void remove(iterator it) const {
     if (!data_)
       return;
-    data_->removeSlot(it.slot_);
+    data_->removeSlot(it.slot_, pool_);
   }
 
   // Removes the member with the specified key.
-  // ⚠️ Doesn't release the memory associated with the removed member.
+  // The pool reuses the memory of the removed member.
   // https://arduinojson.org/v6/api/jsonobject/remove/
   template <typename TString>
   FORCE_INLINE void remove(const TString& key) const {
@@ -143,7 +144,7 @@ class JsonObject : public detail::VariantOperators<JsonObject> {
   }
 
   // Removes the member with the specified key.
-  // ⚠️ Doesn't release the memory associated with the removed member.
+  // The pool reuses the memory of the removed member.
   // https://arduinojson.org/v6/api/jsonobject/remove/
   template <typename TChar>
   FORCE_INLINE void remove(TChar* key) const {
@@ -216,7 +217,7 @@ class JsonObject : public detail::VariantOperators<JsonObject> {
   void removeMember(TAdaptedString key) const {
     if (!data_)
       return;
-    data_->removeMember(key);
+    data_->removeMember(key, pool_);
   }
 
   detail::CollectionData* data_;
@@ -230,8 +231,8 @@ struct Converter<JsonObject> : private detail::VariantAttorney {
   }
 
   static JsonObject fromJson(JsonVariant src) {
-    auto data = getData(src);
     auto pool = getPool(src);
+    auto data = variantResolve(getData(src), pool);
     return JsonObject(pool, data != 0 ? data->asObject() : 0);
   }
 
@@ -243,7 +244,7 @@ struct Converter<JsonObject> : private detail::VariantAttorney {
   }
 
   static bool checkJson(JsonVariant src) {
-    auto data = getData(src);
+    auto data = variantResolve(getData(src), getPool(src));
     return data && data->isObject();
   }
 };
@@ -17,8 +17,9 @@ class JsonPair {
   // INTERNAL USE ONLY
   JsonPair(detail::MemoryPool* pool, detail::VariantSlot* slot) {
     if (slot) {
-      key_ = JsonString(slot->key(), slot->ownsKey() ? JsonString::Copied
-                                                     : JsonString::Linked);
+      key_ = JsonString(
+          slot->key(), slot->keySize(),
+          slot->ownsKey() ? JsonString::Copied : JsonString::Linked);
       value_ = JsonVariant(pool, slot->data());
     }
   }
@@ -44,8 +45,9 @@ class JsonPairConst {
  public:
   JsonPairConst(const detail::VariantSlot* slot) {
     if (slot) {
-      key_ = JsonString(slot->key(), slot->ownsKey() ? JsonString::Copied
-                                                     : JsonString::Linked);
+      key_ = JsonString(
+          slot->key(), slot->keySize(),
+          slot->ownsKey() ? JsonString::Copied : JsonString::Linked);
       value_ = JsonVariantConst(slot->data());
     }
   }
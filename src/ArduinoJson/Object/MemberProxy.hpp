@@ -46,14 +46,17 @@ class MemberProxy
   }
 
   FORCE_INLINE VariantData* getData() const {
-    return variantGetMember(VariantAttorney::getData(upstream_),
-                            adaptString(key_));
+    MemoryPool* pool = VariantAttorney::getPool(upstream_);
+    return variantGetMember(
+        variantResolve(VariantAttorney::getData(upstream_), pool),
+        adaptString(key_));
   }
 
   FORCE_INLINE VariantData* getOrCreateData() const {
-    return variantGetOrAddMember(VariantAttorney::getOrCreateData(upstream_),
-                                 adaptString(key_),
-                                 VariantAttorney::getPool(upstream_));
+    MemoryPool* pool = VariantAttorney::getPool(upstream_);
+    return variantGetOrAddMember(
+        variantResolve(VariantAttorney::getOrCreateData(upstream_), pool),
+        adaptString(key_), pool);
   }
 
  private:
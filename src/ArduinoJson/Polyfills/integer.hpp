@@ -4,7 +4,7 @@
 
 #pragma once
 
-#include <stdint.h>  // int8_t, int16_t
+#include <stdint.h>  // int8_t, int16_t, uint8_t, uint16_t
 
 #include <ArduinoJson/Namespace.hpp>
 
@@ -28,4 +28,22 @@ struct int_t<32> {
   typedef int32_t type;
 };
 
+template <int Bits>
+struct uint_t;
+
+template <>
+struct uint_t<8> {
+  typedef uint8_t type;
+};
+
+template <>
+struct uint_t<16> {
+  typedef uint16_t type;
+};
+
+template <>
+struct uint_t<32> {
+  typedef uint32_t type;
+};
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -16,7 +16,7 @@ class StringCopier {
     pool_->getFreeZone(&ptr_, &capacity_);
     size_ = 0;
     if (capacity_ == 0)
-      pool_->markAsOverflowed();
+      reserve(1);
   }
 
   JsonString save() {
@@ -37,10 +37,20 @@ class StringCopier {
   }
 
   void append(char c) {
-    if (size_ + 1 < capacity_)
+    if (size_ + 1 < capacity_ || reserve(1))
       ptr_[size_++] = c;
-    else
-      pool_->markAsOverflowed();
+  }
+
+  // Reads n characters directly into the free zone.
+  // Returns false if the input ended prematurely.
+  template <typename TReader>
+  bool appendFrom(TReader& reader, size_t n) {
+    // needs room for the terminator
+    if (size_ + n >= capacity_ && !reserve(n))
+      return true;
+    size_t count = reader.readBytes(ptr_ + size_, n);
+    size_ += count;
+    return count == n;
   }
 
   bool isValid() const {
@@ -59,6 +69,20 @@ class StringCopier {
   }
 
  private:
+  // Moves the string to a new block of a growable pool, with room for n more
+  // characters and the terminator. Marks the pool as overflowed otherwise.
+  bool reserve(size_t n) {
+    if (pool_->overflowed())
+      return false;
+    size_t required = size_ + n + 1;
+    if (required < 2 * size_)  // amortizes the copies of long strings
+      required = 2 * size_;
+    if (!pool_->growFreeZone(size_, required))
+      return false;
+    pool_->getFreeZone(&ptr_, &capacity_);
+    return true;
+  }
+
   MemoryPool* pool_;
 
   // These fields aren't initialized by the constructor but startString()
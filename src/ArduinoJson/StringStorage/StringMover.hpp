@@ -27,6 +27,20 @@ class StringMover {
     *writePtr_++ = c;
   }
 
+  // Reads n characters from the input.
+  // Returns false if the input ended prematurely.
+  template <typename TReader>
+  bool appendFrom(TReader& reader, size_t n) {
+    // the destination overlaps the source, so we copy one byte at a time
+    for (; n; --n) {
+      int c = reader.read();
+      if (c < 0)
+        return false;
+      append(static_cast<char>(c));
+    }
+    return true;
+  }
+
   bool isValid() const {
     return true;
   }
@@ -5,7 +5,7 @@
 #pragma once
 
 #include <stddef.h>  // size_t
-#include <string.h>  // strcmp
+#include <string.h>  // memcmp, strcmp
 
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Strings/StoragePolicy.hpp>
@@ -50,7 +50,8 @@ class ZeroTerminatedRamString {
 
   friend bool stringEquals(ZeroTerminatedRamString a,
                            ZeroTerminatedRamString b) {
-    return stringCompare(a, b) == 0;
+    // keys linked to a KeyDictionary are often the same pointer
+    return a.str_ == b.str_ || stringCompare(a, b) == 0;
   }
 
   StringStoragePolicy::Copy storagePolicy() const {
@@ -130,6 +131,20 @@ class SizedRamString {
   size_t size_;
 };
 
+// Compares the characters at once, unlike the generic stringEquals()
+template <typename TAdaptedString>
+typename enable_if<is_base_of<ZeroTerminatedRamString, TAdaptedString>::value ||
+                       is_base_of<SizedRamString, TAdaptedString>::value,
+                   bool>::type
+stringEquals(TAdaptedString a, SizedRamString b) {
+  ARDUINOJSON_ASSERT(!a.isNull());
+  ARDUINOJSON_ASSERT(!b.isNull());
+  size_t n = b.size();
+  if (a.size() != n)
+    return false;
+  return a.data() == b.data() || ::memcmp(a.data(), b.data(), n) == 0;
+}
+
 template <typename TChar>
 struct SizedStringAdapter<TChar*,
                           typename enable_if<IsChar<TChar>::value>::type> {
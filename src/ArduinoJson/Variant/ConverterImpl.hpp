@@ -125,12 +125,14 @@ struct Converter<const char*> : private detail::VariantAttorney {
 
   static const char* fromJson(JsonVariantConst src) {
     auto data = getData(src);
-    return data ? data->asString().c_str() : 0;
+    if (!data || data->isUnterminatedString())
+      return 0;
+    return data->asString().c_str();
   }
 
   static bool checkJson(JsonVariantConst src) {
     auto data = getData(src);
-    return data && data->isString();
+    return data && data->isString() && !data->isUnterminatedString();
   }
 };
 
@@ -151,6 +153,25 @@ struct Converter<JsonString> : private detail::VariantAttorney {
   }
 };
 
+template <>
+struct Converter<JsonBinary> : private detail::VariantAttorney {
+  static void toJson(JsonBinary src, JsonVariant dst) {
+    auto data = getData(dst);
+    if (data)
+      data->setBinary(src, getPool(dst));
+  }
+
+  static JsonBinary fromJson(JsonVariantConst src) {
+    auto data = getData(src);
+    return data ? data->asBinary() : JsonBinary();
+  }
+
+  static bool checkJson(JsonVariantConst src) {
+    auto data = getData(src);
+    return data && data->isBinary();
+  }
+};
+
 template <typename T>
 inline typename detail::enable_if<detail::IsString<T>::value, bool>::type
 convertToJson(const T& src, JsonVariant dst) {
@@ -266,10 +287,14 @@ inline void convertToJson(const ::Printable& src, JsonVariant dst) {
 
 inline void convertFromJson(JsonVariantConst src, ::String& dst) {
   JsonString str = src.as<JsonString>();
-  if (str)
-    dst = str.c_str();
-  else
+  if (str) {
+    // the string may not be null-terminated (see ZeroCopy)
+    dst = "";
+    detail::Writer<::String> writer(dst);
+    writer.write(reinterpret_cast<const uint8_t*>(str.c_str()), str.size());
+  } else {
     serializeJson(src, dst);
+  }
 }
 
 inline bool canConvertFromJson(JsonVariantConst src, const ::String&) {
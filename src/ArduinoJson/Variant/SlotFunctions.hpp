@@ -9,34 +9,53 @@
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
+inline bool VariantSlot::setKey(JsonString k, MemoryPool* pool) {
+  ARDUINOJSON_ASSERT(k);
+  if (k.isLinked())
+    flags_ &= VALUE_MASK;
+  else
+    flags_ |= OWNED_KEY_BIT;
+#if ARDUINOJSON_STORE_KEY_SIZE
+  // the keys end at the first NUL, like in the lookups
+  size_t n = strlen(k.c_str());
+  keySize_ = uint8_t(n < maxStoredKeySize ? n : maxStoredKeySize);
+#endif
+#if ARDUINOJSON_COMPACT_SLOTS
+  ARDUINOJSON_ASSERT(pool != 0);
+  const char* storage = k.isLinked() ? pool->savePointer(k.c_str()) : k.c_str();
+  if (!storage)
+    return false;
+  key_ = int32_t(storage - reinterpret_cast<const char*>(this));
+#else
+  (void)pool;
+  key_ = k.c_str();
+#endif
+  return true;
+}
+
 struct SlotKeySetter {
-  SlotKeySetter(VariantSlot* instance) : instance_(instance) {}
+  SlotKeySetter(VariantSlot* instance, MemoryPool* pool, bool* ok)
+      : instance_(instance), pool_(pool), ok_(ok) {}
 
   template <typename TStoredString>
   void operator()(TStoredString s) {
     if (!s)
       return;
     ARDUINOJSON_ASSERT(instance_ != 0);
-    instance_->setKey(s);
+    *ok_ = instance_->setKey(s, pool_);
   }
 
   VariantSlot* instance_;
+  MemoryPool* pool_;
+  bool* ok_;
 };
 
 template <typename TAdaptedString>
 inline bool slotSetKey(VariantSlot* var, TAdaptedString key, MemoryPool* pool) {
   if (!var)
     return false;
-  return storeString(pool, key, SlotKeySetter(var));
-}
-
-inline size_t slotSize(const VariantSlot* var) {
-  size_t n = 0;
-  while (var) {
-    n++;
-    var = var->next();
-  }
-  return n;
+  bool ok = true;
+  return storeString(pool, key, SlotKeySetter(var, pool, &ok)) && ok;
 }
 
 inline VariantData* slotData(VariantSlot* slot) {
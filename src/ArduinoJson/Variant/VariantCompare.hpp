@@ -80,6 +80,20 @@ struct Comparer<decltype(nullptr), void> : NullComparer {
   explicit Comparer(decltype(nullptr)) : NullComparer() {}
 };
 
+template <>
+struct Comparer<JsonBinary, void> : ComparerBase {
+  JsonBinary rhs;
+
+  explicit Comparer(JsonBinary value) : rhs(value) {}
+
+  CompareResult visitBinary(JsonBinary lhs) {
+    if (lhs == rhs)
+      return COMPARE_RESULT_EQUAL;
+    else
+      return COMPARE_RESULT_DIFFER;
+  }
+};
+
 struct ArrayComparer : ComparerBase {
   const CollectionData* rhs_;
 
@@ -145,8 +159,8 @@ struct VariantComparer : ComparerBase {
     return accept(comparer);
   }
 
-  CompareResult visitString(const char* lhs, size_t) {
-    Comparer<const char*> comparer(lhs);
+  CompareResult visitString(const char* lhs, size_t n) {
+    Comparer<JsonString> comparer(JsonString(lhs, n));
     return accept(comparer);
   }
 
@@ -155,6 +169,11 @@ struct VariantComparer : ComparerBase {
     return accept(comparer);
   }
 
+  CompareResult visitBinary(JsonBinary lhs) {
+    Comparer<JsonBinary> comparer(lhs);
+    return accept(comparer);
+  }
+
   CompareResult visitSignedInteger(JsonInteger lhs) {
     Comparer<JsonInteger> comparer(lhs);
     return accept(comparer);
@@ -21,6 +21,13 @@ enum {
   VALUE_IS_OWNED_RAW = 0x03,
   VALUE_IS_LINKED_STRING = 0x04,
   VALUE_IS_OWNED_STRING = 0x05,
+  VALUE_IS_LINKED_LAZY = 0x10,  // see DeserializationOption::Lazy
+  VALUE_IS_OWNED_LAZY = 0x11,
+  VALUE_IS_UNTERMINATED_STRING = 0x12,  // linked, see ZeroCopy
+  VALUE_IS_LINKED_BINARY = 0x14,
+  VALUE_IS_OWNED_BINARY = 0x15,
+  VALUE_IS_LINKED_EXT = 0x16,  // the first byte is the extension type
+  VALUE_IS_OWNED_EXT = 0x17,
 
   // CAUTION: no OWNED_VALUE_BIT below
 
@@ -30,6 +37,7 @@ enum {
   VALUE_IS_UNSIGNED_INTEGER = 0x08,
   VALUE_IS_SIGNED_INTEGER = 0x0A,
   VALUE_IS_FLOAT = 0x0C,
+  VALUE_IS_INLINE_STRING = 0x0E,  // CAUTION: not a number
 
   COLLECTION_MASK = 0x60,
   VALUE_IS_OBJECT = 0x20,
@@ -53,6 +61,11 @@ union VariantContent {
     const char* data;
     size_t size;
   } asString;
+  // The characters, the terminator, and, in the last byte, the number of
+  // unused characters, which is the terminator when the string is full
+  char asInlineString[sizeof(RawData)];
 };
 
+const size_t inlineStringCapacity = sizeof(RawData) - 1;
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
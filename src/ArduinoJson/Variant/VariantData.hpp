@@ -7,6 +7,7 @@
 #include <ArduinoJson/Memory/MemoryPool.hpp>
 #include <ArduinoJson/Misc/SerializedValue.hpp>
 #include <ArduinoJson/Numbers/convertNumber.hpp>
+#include <ArduinoJson/Misc/JsonBinary.hpp>
 #include <ArduinoJson/Strings/JsonString.hpp>
 #include <ArduinoJson/Strings/StringAdapters.hpp>
 #include <ArduinoJson/Variant/VariantContent.hpp>
@@ -39,14 +40,27 @@ class VariantData {
 
       case VALUE_IS_LINKED_STRING:
       case VALUE_IS_OWNED_STRING:
+      case VALUE_IS_UNTERMINATED_STRING:
         return visitor.visitString(content_.asString.data,
                                    content_.asString.size);
 
+      case VALUE_IS_INLINE_STRING:
+        return visitor.visitString(content_.asInlineString,
+                                   inlineStringSize());
+
       case VALUE_IS_OWNED_RAW:
       case VALUE_IS_LINKED_RAW:
+      case VALUE_IS_OWNED_LAZY:
+      case VALUE_IS_LINKED_LAZY:
         return visitor.visitRawJson(content_.asString.data,
                                     content_.asString.size);
 
+      case VALUE_IS_LINKED_BINARY:
+      case VALUE_IS_OWNED_BINARY:
+      case VALUE_IS_LINKED_EXT:
+      case VALUE_IS_OWNED_EXT:
+        return visitor.visitBinary(asBinary());
+
       case VALUE_IS_SIGNED_INTEGER:
         return visitor.visitSignedInteger(content_.asSignedInteger);
 
@@ -71,6 +85,21 @@ class VariantData {
 
   bool asBoolean() const;
 
+  JsonBinary asBinary() const {
+    switch (type()) {
+      case VALUE_IS_LINKED_BINARY:
+      case VALUE_IS_OWNED_BINARY:
+        return JsonBinary(content_.asString.data, content_.asString.size);
+      case VALUE_IS_LINKED_EXT:
+      case VALUE_IS_OWNED_EXT:
+        return JsonBinary(static_cast<int8_t>(content_.asString.data[0]),
+                          content_.asString.data + 1,
+                          content_.asString.size - 1);
+      default:
+        return JsonBinary();
+    }
+  }
+
   CollectionData* asArray() {
     return isArray() ? &content_.asCollection : 0;
   }
@@ -97,6 +126,18 @@ class VariantData {
     return (flags_ & VALUE_IS_ARRAY) != 0;
   }
 
+  bool isBinary() const {
+    switch (type()) {
+      case VALUE_IS_LINKED_BINARY:
+      case VALUE_IS_OWNED_BINARY:
+      case VALUE_IS_LINKED_EXT:
+      case VALUE_IS_OWNED_EXT:
+        return true;
+      default:
+        return false;
+    }
+  }
+
   bool isBoolean() const {
     return type() == VALUE_IS_BOOLEAN;
   }
@@ -120,11 +161,20 @@ class VariantData {
   }
 
   bool isFloat() const {
-    return (flags_ & NUMBER_BIT) != 0;
+    return (flags_ & NUMBER_BIT) != 0 && type() != VALUE_IS_INLINE_STRING;
   }
 
   bool isString() const {
-    return type() == VALUE_IS_LINKED_STRING || type() == VALUE_IS_OWNED_STRING;
+    return type() == VALUE_IS_LINKED_STRING ||
+           type() == VALUE_IS_OWNED_STRING ||
+           type() == VALUE_IS_UNTERMINATED_STRING ||
+           type() == VALUE_IS_INLINE_STRING;
+  }
+
+  // Strings that point to the input of deserializeMsgPack(), see
+  // DeserializationOption::ZeroCopy
+  bool isUnterminatedString() const {
+    return type() == VALUE_IS_UNTERMINATED_STRING;
   }
 
   bool isObject() const {
@@ -135,26 +185,47 @@ class VariantData {
     return type() == VALUE_IS_NULL;
   }
 
+  bool isLazy() const {
+    return type() == VALUE_IS_LINKED_LAZY || type() == VALUE_IS_OWNED_LAZY;
+  }
+
   bool isEnclosed() const {
     return !isFloat();
   }
 
-  void remove(size_t index) {
+  void remove(size_t index, MemoryPool* pool) {
     if (isArray())
-      content_.asCollection.removeElement(index);
+      content_.asCollection.removeElement(index, pool);
   }
 
   template <typename TAdaptedString>
-  void remove(TAdaptedString key) {
+  void remove(TAdaptedString key, MemoryPool* pool) {
     if (isObject())
-      content_.asCollection.removeMember(key);
+      content_.asCollection.removeMember(key, pool);
   }
 
+  // Gives the owned string or the slots of the value back to the pool.
+  // The value must be replaced afterward.
+  void release(MemoryPool* pool);
+
   void setBoolean(bool value) {
     setType(VALUE_IS_BOOLEAN);
     content_.asBoolean = value;
   }
 
+  // Stores the bytes of a bin value, see JsonBinary
+  void setBinary(JsonString bytes) {
+    setBytes(bytes, VALUE_IS_LINKED_BINARY);
+  }
+
+  // Stores the extension type followed by the bytes of an ext value
+  void setExt(JsonString bytes) {
+    ARDUINOJSON_ASSERT(bytes.size() > 0);
+    setBytes(bytes, VALUE_IS_LINKED_EXT);
+  }
+
+  bool setBinary(JsonBinary value, MemoryPool* pool);
+
   void setFloat(JsonFloat value) {
     setType(VALUE_IS_FLOAT);
     content_.asFloat = value;
@@ -170,6 +241,35 @@ class VariantData {
     }
   }
 
+  void setRaw(JsonString s) {
+    ARDUINOJSON_ASSERT(s);
+    if (s.isLinked())
+      setType(VALUE_IS_LINKED_RAW);
+    else
+      setType(VALUE_IS_OWNED_RAW);
+    content_.asString.data = s.c_str();
+    content_.asString.size = s.size();
+  }
+
+  // Stores unparsed JSON, see DeserializationOption::Lazy
+  void setLazy(JsonString s) {
+    ARDUINOJSON_ASSERT(s);
+    if (s.isLinked())
+      setType(VALUE_IS_LINKED_LAZY);
+    else
+      setType(VALUE_IS_OWNED_LAZY);
+    content_.asString.data = s.c_str();
+    content_.asString.size = s.size();
+  }
+
+  JsonString asLazy() const {
+    if (!isLazy())
+      return JsonString();
+    return JsonString(content_.asString.data, content_.asString.size,
+                      type() == VALUE_IS_LINKED_LAZY ? JsonString::Linked
+                                                     : JsonString::Copied);
+  }
+
   template <typename T>
   bool storeOwnedRaw(SerializedValue<T> value, MemoryPool* pool) {
     const char* dup = pool->saveString(adaptString(value.data(), value.size()));
@@ -210,6 +310,13 @@ class VariantData {
     content_.asString.size = s.size();
   }
 
+  void setUnterminatedString(const char* s, size_t n) {
+    ARDUINOJSON_ASSERT(s);
+    setType(VALUE_IS_UNTERMINATED_STRING);
+    content_.asString.data = s;
+    content_.asString.size = n;
+  }
+
   CollectionData& toArray() {
     setType(VALUE_IS_ARRAY);
     content_.asCollection.clear();
@@ -226,6 +333,9 @@ class VariantData {
     switch (type()) {
       case VALUE_IS_OWNED_STRING:
       case VALUE_IS_OWNED_RAW:
+      case VALUE_IS_OWNED_LAZY:
+      case VALUE_IS_OWNED_BINARY:
+      case VALUE_IS_OWNED_EXT:
         // We always add a zero at the end: the deduplication function uses it
         // to detect the beginning of the next string.
         return content_.asString.size + 1;
@@ -284,6 +394,24 @@ class VariantData {
       content_.asCollection.movePointers(stringDistance, variantDistance);
   }
 
+  // Reports the strings and the slots this value refers to, see PoolCompactor
+  template <typename TMarker>
+  void mark(TMarker& marker) const {
+    if (flags_ & OWNED_VALUE_BIT)
+      marker.markString(content_.asString.data, content_.asString.size + 1);
+    if (flags_ & COLLECTION_MASK)
+      content_.asCollection.mark(marker);
+  }
+
+  // Replaces the pointers with their new addresses, see PoolCompactor
+  template <typename TRelocator>
+  void relocate(const TRelocator& relocator) {
+    if (flags_ & OWNED_VALUE_BIT)
+      content_.asString.data = relocator.newAddress(content_.asString.data);
+    if (flags_ & COLLECTION_MASK)
+      content_.asCollection.relocate(relocator);
+  }
+
   uint8_t type() const {
     return flags_ & VALUE_MASK;
   }
@@ -295,15 +423,72 @@ class VariantData {
       return true;
     }
 
+#if ARDUINOJSON_INLINE_SHORT_STRINGS
+    if (isCopied(value.storagePolicy()) && setInlineString(value))
+      return true;
+#endif
+
     return storeString(pool, value, VariantStringSetter(this));
   }
 
+  // Sets the string that a deserializer built in its string storage
+  template <typename TStringStorage>
+  void setString(TStringStorage& storage) {
+#if ARDUINOJSON_INLINE_SHORT_STRINGS
+    JsonString s = storage.str();
+    if (!s.isLinked() && setInlineString(adaptString(s)))
+      return;  // the storage reuses the room for the next string
+#endif
+    setString(storage.save());
+  }
+
  private:
   void setType(uint8_t t) {
     flags_ &= OWNED_KEY_BIT;
     flags_ |= t;
   }
 
+  // Copies the string in the variant, unless it's too long
+  template <typename TAdaptedString>
+  bool setInlineString(TAdaptedString value) {
+    size_t n = value.size();
+    if (n > inlineStringCapacity)
+      return false;
+    setType(VALUE_IS_INLINE_STRING);
+    stringGetChars(value, content_.asInlineString, n);
+    content_.asInlineString[n] = 0;
+    content_.asInlineString[inlineStringCapacity] =
+        char(inlineStringCapacity - n);
+    return true;
+  }
+
+  size_t inlineStringSize() const {
+    return inlineStringCapacity -
+           size_t(uint8_t(content_.asInlineString[inlineStringCapacity]));
+  }
+
+  static bool isCopied(StringStoragePolicy::Copy) {
+    return true;
+  }
+
+  static bool isCopied(StringStoragePolicy::Link) {
+    return false;
+  }
+
+  static bool isCopied(StringStoragePolicy::LinkOrCopy policy) {
+    return !policy.link;
+  }
+
+  void setBytes(JsonString bytes, uint8_t linkedType) {
+    ARDUINOJSON_ASSERT(bytes);
+    if (bytes.isLinked())
+      setType(linkedType);
+    else
+      setType(uint8_t(linkedType | OWNED_VALUE_BIT));
+    content_.asString.data = bytes.c_str();
+    content_.asString.size = bytes.size();
+  }
+
   struct VariantStringSetter {
     VariantStringSetter(VariantData* instance) : instance_(instance) {}
 
@@ -37,6 +37,14 @@ inline void variantSetNull(VariantData* var) {
   var->setNull();
 }
 
+// Same as above, but gives the previous value back to the pool
+inline void variantSetNull(VariantData* var, MemoryPool* pool) {
+  if (!var)
+    return;
+  var->release(pool);
+  var->setNull();
+}
+
 template <typename TAdaptedString>
 inline bool variantSetString(VariantData* var, TAdaptedString value,
                              MemoryPool* pool) {
@@ -47,15 +55,17 @@ inline size_t variantSize(const VariantData* var) {
   return var != 0 ? var->size() : 0;
 }
 
-inline CollectionData* variantToArray(VariantData* var) {
+inline CollectionData* variantToArray(VariantData* var, MemoryPool* pool) {
   if (!var)
     return 0;
+  var->release(pool);
   return &var->toArray();
 }
 
-inline CollectionData* variantToObject(VariantData* var) {
+inline CollectionData* variantToObject(VariantData* var, MemoryPool* pool) {
   if (!var)
     return 0;
+  var->release(pool);
   return &var->toObject();
 }
 
@@ -89,6 +99,10 @@ VariantData* variantGetOrAddMember(VariantData* var, TAdaptedString key,
   return var->getOrAddMember(key, pool);
 }
 
+// Parses a lazy value in place (see DeserializationOption::Lazy).
+// Defined in JsonDeserializer.hpp.
+inline VariantData* variantResolve(VariantData* var, MemoryPool* pool);
+
 inline bool variantIsNull(const VariantData* var) {
   return var == 0 || var->isNull();
 }
@@ -9,6 +9,7 @@
 #include <ArduinoJson/Numbers/convertNumber.hpp>
 #include <ArduinoJson/Numbers/parseNumber.hpp>
 #include <ArduinoJson/Object/JsonObject.hpp>
+#include <ArduinoJson/StringStorage/StringCopier.hpp>
 #include <ArduinoJson/Variant/JsonVariant.hpp>
 
 #include <string.h>  // for strcmp
@@ -27,6 +28,8 @@ inline T VariantData::asIntegral() const {
     case VALUE_IS_LINKED_STRING:
     case VALUE_IS_OWNED_STRING:
       return parseNumber<T>(content_.asString.data);
+    case VALUE_IS_INLINE_STRING:
+      return parseNumber<T>(content_.asInlineString);
     case VALUE_IS_FLOAT:
       return convertNumber<T>(content_.asFloat);
     default:
@@ -63,6 +66,8 @@ inline T VariantData::asFloat() const {
     case VALUE_IS_LINKED_STRING:
     case VALUE_IS_OWNED_STRING:
       return parseNumber<T>(content_.asString.data);
+    case VALUE_IS_INLINE_STRING:
+      return parseNumber<T>(content_.asInlineString);
     case VALUE_IS_FLOAT:
       return static_cast<T>(content_.asFloat);
     default:
@@ -73,16 +78,32 @@ inline T VariantData::asFloat() const {
 inline JsonString VariantData::asString() const {
   switch (type()) {
     case VALUE_IS_LINKED_STRING:
+    case VALUE_IS_UNTERMINATED_STRING:
       return JsonString(content_.asString.data, content_.asString.size,
                         JsonString::Linked);
     case VALUE_IS_OWNED_STRING:
       return JsonString(content_.asString.data, content_.asString.size,
                         JsonString::Copied);
+    case VALUE_IS_INLINE_STRING:
+      return JsonString(content_.asInlineString, inlineStringSize(),
+                        JsonString::Copied);
     default:
       return JsonString();
   }
 }
 
+inline void VariantData::release(MemoryPool* pool) {
+  if (!pool)
+    return;
+  if (flags_ & OWNED_VALUE_BIT) {
+    // not in the pool after shallowCopy()
+    if (pool->owns(const_cast<char*>(content_.asString.data)))
+      pool->freeString(content_.asString.data, content_.asString.size + 1);
+  } else if (flags_ & COLLECTION_MASK) {
+    content_.asCollection.release(pool);
+  }
+}
+
 inline bool VariantData::copyFrom(const VariantData& src, MemoryPool* pool) {
   switch (src.type()) {
     case VALUE_IS_ARRAY:
@@ -97,6 +118,16 @@ inline bool VariantData::copyFrom(const VariantData& src, MemoryPool* pool) {
       return storeOwnedRaw(
           serialized(src.content_.asString.data, src.content_.asString.size),
           pool);
+    case VALUE_IS_OWNED_BINARY:
+    case VALUE_IS_OWNED_EXT:
+      return setBinary(src.asBinary(), pool);
+    case VALUE_IS_OWNED_LAZY: {
+      JsonString json = src.asLazy();
+      if (!storeOwnedRaw(serialized(json.c_str(), json.size()), pool))
+        return false;
+      setType(VALUE_IS_OWNED_LAZY);
+      return true;
+    }
     default:
       setType(src.type());
       content_ = src.content_;
@@ -104,10 +135,34 @@ inline bool VariantData::copyFrom(const VariantData& src, MemoryPool* pool) {
   }
 }
 
+inline bool VariantData::setBinary(JsonBinary value, MemoryPool* pool) {
+  if (!value) {
+    setNull();
+    return true;
+  }
+
+  StringCopier copier(pool);
+  copier.startString();
+  if (value.isExt())
+    copier.append(static_cast<char>(value.extType()));
+  copier.append(reinterpret_cast<const char*>(value.data()), value.size());
+  if (!copier.isValid()) {
+    setNull();
+    return false;
+  }
+
+  if (value.isExt())
+    setExt(copier.save());
+  else
+    setBinary(copier.save());
+  return true;
+}
+
 template <typename TDerived>
 inline JsonVariant VariantRefBase<TDerived>::add() const {
-  return JsonVariant(getPool(),
-                     variantAddElement(getOrCreateData(), getPool()));
+  MemoryPool* pool = getPool();
+  return JsonVariant(
+      pool, variantAddElement(variantResolve(getOrCreateData(), pool), pool));
 }
 
 template <typename TDerived>
@@ -120,18 +175,52 @@ inline JsonVariant VariantRefBase<TDerived>::getOrCreateVariant() const {
   return JsonVariant(getPool(), getOrCreateData());
 }
 
+// Tells whether value refers to the specified variant
+template <typename T>
+inline typename enable_if<IsVariant<T>::value, bool>::type refersTo(
+    const T& value, const VariantData* data) {
+  return VariantAttorney::getData(value) == data;
+}
+
+template <typename T>
+inline typename enable_if<!IsVariant<T>::value, bool>::type refersTo(
+    const T&, const VariantData*) {
+  return false;
+}
+
+template <typename TDerived>
+template <typename TConverter, typename T>
+inline bool VariantRefBase<TDerived>::setWith(const T& value) const {
+  MemoryPool* pool = getPool();
+  VariantData* data = getOrCreateData();
+  // Assigning a variant to itself (e.g., doc["a"] = doc["a"]) is a no-op
+  if (data && refersTo(value, data))
+    return pool && !pool->overflowed();
+  // The previous value is released after the conversion, because the new
+  // value may come from it (e.g., doc["a"] = doc["a"]["b"]).
+  // It is detached first, so that the converter doesn't release it again.
+  VariantData previous;
+  if (data) {
+    previous = *data;
+    data->setNull();
+  }
+  TConverter::toJson(value, JsonVariant(pool, data));
+  previous.release(pool);
+  return pool && !pool->overflowed();
+}
+
 template <typename TDerived>
 template <typename T>
 inline typename enable_if<is_same<T, JsonArray>::value, JsonArray>::type
 VariantRefBase<TDerived>::to() const {
-  return JsonArray(getPool(), variantToArray(getOrCreateData()));
+  return JsonArray(getPool(), variantToArray(getOrCreateData(), getPool()));
 }
 
 template <typename TDerived>
 template <typename T>
 typename enable_if<is_same<T, JsonObject>::value, JsonObject>::type
 VariantRefBase<TDerived>::to() const {
-  return JsonObject(getPool(), variantToObject(getOrCreateData()));
+  return JsonObject(getPool(), variantToObject(getOrCreateData(), getPool()));
 }
 
 template <typename TDerived>
@@ -139,7 +228,7 @@ template <typename T>
 typename enable_if<is_same<T, JsonVariant>::value, JsonVariant>::type
 VariantRefBase<TDerived>::to() const {
   auto data = getOrCreateData();
-  variantSetNull(data);
+  variantSetNull(data, getPool());
   return JsonVariant(getPool(), data);
 }
 
@@ -27,10 +27,10 @@ class VariantRefBase : public VariantTag {
 
  public:
   // Sets the value to null.
-  // ⚠️ Doesn't release the memory associated with the previous value.
+  // The pool reuses the memory of the previous value.
   // https://arduinojson.org/v6/api/jsonvariant/clear/
   FORCE_INLINE void clear() const {
-    variantSetNull(getData());
+    variantSetNull(VariantAttorney::getData(derived()), getPool());
   }
 
   // Returns true if the value is null or the reference is unbound.
@@ -41,7 +41,7 @@ class VariantRefBase : public VariantTag {
 
   // Returns true if the reference is unbound.
   FORCE_INLINE bool isUnbound() const {
-    return !getData();
+    return !VariantAttorney::getData(derived());
   }
 
   // Casts the value to the specified type.
@@ -67,20 +67,20 @@ class VariantRefBase : public VariantTag {
   }
 
   // Sets the value to an empty array.
-  // ⚠️ Doesn't release the memory associated with the previous value.
+  // The pool reuses the memory of the previous value.
   // https://arduinojson.org/v6/api/jsonvariant/to/
   template <typename T>
   typename enable_if<is_same<T, JsonArray>::value, JsonArray>::type to() const;
 
   // Sets the value to an empty object.
-  // ⚠️ Doesn't release the memory associated with the previous value.
+  // The pool reuses the memory of the previous value.
   // https://arduinojson.org/v6/api/jsonvariant/to/
   template <typename T>
   typename enable_if<is_same<T, JsonObject>::value, JsonObject>::type to()
       const;
 
   // Sets the value to null.
-  // ⚠️ Doesn't release the memory associated with the previous value.
+  // The pool reuses the memory of the previous value.
   // https://arduinojson.org/v6/api/jsonvariant/to/
   template <typename T>
   typename enable_if<is_same<T, JsonVariant>::value, JsonVariant>::type to()
@@ -107,6 +107,8 @@ class VariantRefBase : public VariantTag {
   }
 
   // Shallow copies the specified value.
+  // ⚠️ If the target is in the same document, removing or replacing it gives
+  // its memory back to the pool while this value still refers to it.
   // https://arduinojson.org/v6/api/jsonvariant/shallowcopy/
   FORCE_INLINE void shallowCopy(ArduinoJson::JsonVariantConst target) {
     VariantData* data = getOrCreateData();
@@ -120,21 +122,35 @@ class VariantRefBase : public VariantTag {
   }
 
   // Copies the specified value.
+  // The pool reuses the memory of the previous value.
   // https://arduinojson.org/v6/api/jsonvariant/set/
   template <typename T>
-  FORCE_INLINE bool set(const T& value) const {
-    Converter<T>::toJson(value, getOrCreateVariant());
-    MemoryPool* pool = getPool();
-    return pool && !pool->overflowed();
+  FORCE_INLINE typename enable_if<!IsVariant<T>::value ||
+                                      is_same<T, JsonVariantConst>::value,
+                                  bool>::type
+  set(const T& value) const {
+    return setWith<Converter<T>>(value);
+  }
+
+  // Copies the specified value.
+  // The pool reuses the memory of the previous value.
+  // https://arduinojson.org/v6/api/jsonvariant/set/
+  template <typename T>
+  FORCE_INLINE typename enable_if<IsVariant<T>::value &&
+                                      !is_same<T, JsonVariantConst>::value,
+                                  bool>::type
+  set(const T& value) const {
+    // resolves the proxies (e.g., doc["a"]["b"]) before the previous value is
+    // released, since they may point inside
+    return set(value.template as<JsonVariantConst>());
   }
 
   // Copies the specified value.
+  // The pool reuses the memory of the previous value.
   // https://arduinojson.org/v6/api/jsonvariant/set/
   template <typename T>
   FORCE_INLINE bool set(T* value) const {
-    Converter<T*>::toJson(value, getOrCreateVariant());
-    MemoryPool* pool = getPool();
-    return pool && !pool->overflowed();
+    return setWith<Converter<T*>>(value);
   }
 
   // Returns the size of the array or object.
@@ -176,34 +192,34 @@ class VariantRefBase : public VariantTag {
   }
 
   // Removes an element of the array.
-  // ⚠️ Doesn't release the memory associated with the removed element.
+  // The pool reuses the memory of the removed element.
   // https://arduinojson.org/v6/api/jsonvariant/remove/
   FORCE_INLINE void remove(size_t index) const {
     VariantData* data = getData();
     if (data)
-      data->remove(index);
+      data->remove(index, getPool());
   }
 
   // Removes a member of the object.
-  // ⚠️ Doesn't release the memory associated with the removed element.
+  // The pool reuses the memory of the removed element.
   // https://arduinojson.org/v6/api/jsonvariant/remove/
   template <typename TChar>
   FORCE_INLINE typename enable_if<IsString<TChar*>::value>::type remove(
       TChar* key) const {
     VariantData* data = getData();
     if (data)
-      data->remove(adaptString(key));
+      data->remove(adaptString(key), getPool());
   }
 
   // Removes a member of the object.
-  // ⚠️ Doesn't release the memory associated with the removed element.
+  // The pool reuses the memory of the removed element.
   // https://arduinojson.org/v6/api/jsonvariant/remove/
   template <typename TString>
   FORCE_INLINE typename enable_if<IsString<TString>::value>::type remove(
       const TString& key) const {
     VariantData* data = getData();
     if (data)
-      data->remove(adaptString(key));
+      data->remove(adaptString(key), getPool());
   }
 
   // Creates an array and appends it to the array.
@@ -277,8 +293,9 @@ class VariantRefBase : public VariantTag {
     return VariantAttorney::getPool(derived());
   }
 
+  // Parses the value if it's lazy (see DeserializationOption::Lazy)
   FORCE_INLINE VariantData* getData() const {
-    return VariantAttorney::getData(derived());
+    return variantResolve(VariantAttorney::getData(derived()), getPool());
   }
 
   FORCE_INLINE VariantData* getOrCreateData() const {
@@ -293,6 +310,9 @@ class VariantRefBase : public VariantTag {
   }
 
   FORCE_INLINE ArduinoJson::JsonVariant getOrCreateVariant() const;
+
+  template <typename TConverter, typename T>
+  bool setWith(const T& value) const;
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
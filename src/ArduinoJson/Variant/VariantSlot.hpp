@@ -9,9 +9,11 @@
 #include <ArduinoJson/Polyfills/type_traits.hpp>
 #include <ArduinoJson/Variant/VariantContent.hpp>
 
+#include <string.h>  // memcpy, strlen
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
-typedef int_t<ARDUINOJSON_SLOT_OFFSET_SIZE * 8>::type VariantSlotDiff;
+class MemoryPool;
 
 class VariantSlot {
   // CAUTION: same layout as VariantData
@@ -19,8 +21,18 @@ class VariantSlot {
   // (+20% on ESP8266 for example)
   VariantContent content_;
   uint8_t flags_;
+#if ARDUINOJSON_STORE_KEY_SIZE
+  // The size of the key, or maxStoredKeySize if it doesn't fit
+  uint8_t keySize_;
+#endif
   VariantSlotDiff next_;
+#if ARDUINOJSON_COMPACT_SLOTS
+  // Offset from the slot to the key's storage in the pool: the characters of
+  // an owned key, or a copy of the pointer to a linked key.
+  int32_t key_;
+#else
   const char* key_;
+#endif
 
  public:
   // Must be a POD!
@@ -76,17 +88,47 @@ class VariantSlot {
     next_ = VariantSlotDiff(slot - this);
   }
 
-  void setKey(JsonString k) {
-    ARDUINOJSON_ASSERT(k);
-    if (k.isLinked())
-      flags_ &= VALUE_MASK;
-    else
-      flags_ |= OWNED_KEY_BIT;
-    key_ = k.c_str();
-  }
+  // Returns false if the pool is full (only with ARDUINOJSON_COMPACT_SLOTS,
+  // which copies the pointer to a linked key in the pool).
+  // Defined in SlotFunctions.hpp
+  bool setKey(JsonString k, MemoryPool* pool);
 
   const char* key() const {
+#if ARDUINOJSON_COMPACT_SLOTS
+    if (!key_)
+      return 0;
+    if (flags_ & OWNED_KEY_BIT)
+      return keyStorage();
+    const char* k;
+    memcpy(&k, keyStorage(), sizeof(k));  // may be unaligned
+    return k;
+#else
+    return key_;
+#endif
+  }
+
+  size_t keySize() const {
+#if ARDUINOJSON_STORE_KEY_SIZE
+    if (keySize_ < maxStoredKeySize)
+      return keySize_;
+#endif
+    const char* k = key();
+    return k ? strlen(k) : 0;
+  }
+
+  // Returns the bytes that the key takes in the pool, or null if it takes none
+  const char* keyBytes(size_t* size) const {
+#if ARDUINOJSON_COMPACT_SLOTS
+    if (!key_)
+      return 0;
+    *size = (flags_ & OWNED_KEY_BIT) ? keySize() + 1 : sizeof(char*);
+    return keyStorage();
+#else
+    if (!(flags_ & OWNED_KEY_BIT))
+      return 0;
+    *size = keySize() + 1;
     return key_;
+#endif
   }
 
   bool ownsKey() const {
@@ -96,17 +138,57 @@ class VariantSlot {
   void clear() {
     next_ = 0;
     flags_ = 0;
+#if ARDUINOJSON_STORE_KEY_SIZE
+    keySize_ = 0;
+#endif
     key_ = 0;
   }
 
   void movePointers(ptrdiff_t stringDistance, ptrdiff_t variantDistance) {
+#if ARDUINOJSON_COMPACT_SLOTS
+    if (key_)
+      key_ += int32_t(stringDistance - variantDistance);
+#else
     if (flags_ & OWNED_KEY_BIT)
       key_ += stringDistance;
+#endif
     if (flags_ & OWNED_VALUE_BIT)
       content_.asString.data += stringDistance;
     if (flags_ & COLLECTION_MASK)
       content_.asCollection.movePointers(stringDistance, variantDistance);
   }
+
+  // Replaces the pointers with their new addresses, see PoolCompactor.
+  // Unlike movePointers(), it doesn't follow the collections.
+  template <typename TRelocator>
+  void relocate(const TRelocator& relocator) {
+#if ARDUINOJSON_COMPACT_SLOTS
+    if (key_)
+      key_ = int32_t(relocator.newAddress(keyStorage()) -
+                     reinterpret_cast<const char*>(relocator.newAddress(this)));
+#else
+    if (flags_ & OWNED_KEY_BIT)
+      key_ = relocator.newAddress(key_);
+#endif
+    if (next_)
+      next_ = VariantSlotDiff(relocator.newAddress(this + next_) -
+                              relocator.newAddress(this));
+    if (flags_ & OWNED_VALUE_BIT)
+      content_.asString.data = relocator.newAddress(content_.asString.data);
+    if (flags_ & COLLECTION_MASK)
+      content_.asCollection.relocate(relocator);
+  }
+
+ private:
+#if ARDUINOJSON_STORE_KEY_SIZE
+  static const uint8_t maxStoredKeySize = 255;
+#endif
+
+#if ARDUINOJSON_COMPACT_SLOTS
+  const char* keyStorage() const {
+    return reinterpret_cast<const char*>(this) + key_;
+  }
+#endif
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Collection/CollectionData.hpp>
+#include <ArduinoJson/Misc/JsonBinary.hpp>
 #include <ArduinoJson/Numbers/JsonFloat.hpp>
 #include <ArduinoJson/Numbers/JsonInteger.hpp>
 
@@ -18,6 +19,10 @@ struct Visitor {
     return TResult();
   }
 
+  TResult visitBinary(JsonBinary) {
+    return TResult();
+  }
+
   TResult visitBoolean(bool) {
     return TResult();
   }